@@ -0,0 +1,119 @@
+#include "BufferedWriter.hpp"
+
+/* ############################################################################################## */
+
+/**
+ * @file BufferedWriter.cpp
+ * @brief Implementation of the BufferedWriter class.
+ *
+ * This file contains the destinations of the writer and the handling of full buffers.
+ *
+ * @author aheitz
+ * @date Created: 2026-10-17
+ * @date Last Modified: 2026-10-17
+ */
+
+/* ############################################################################################## */
+
+/*
+ * This file is part of the ColorFormat library.
+ *
+ * Copyright (C) 2025 aheitz <alexy.pa.heitz@gmail.com>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+/* ############################################################################################## */
+
+#include <stdexcept>
+
+/* ############################################################################################## */
+
+/**
+ * @brief Raises a capacity to BufferedWriter::minimumCapacity.
+ *
+ * Below it, append(char) would write into an empty buffer, and the colorizers would throw
+ * from acquire() on their first sequence.
+ */
+static size_t bounded(const size_t capacity) {
+	return capacity < static_cast<size_t>(BufferedWriter::minimumCapacity) ? static_cast<size_t>(BufferedWriter::minimumCapacity) : capacity;
+}
+
+BufferedWriter::BufferedWriter(std::ostream &stream, const size_t capacity)
+	: _sink(&writeStream), _destination(&stream), _buffer(new char[bounded(capacity)]), _capacity(bounded(capacity)), _length(0), _flushed(0) {}
+
+BufferedWriter::BufferedWriter(std::FILE *file, const size_t capacity)
+	: _sink(&writeFile), _destination(file), _buffer(new char[bounded(capacity)]), _capacity(bounded(capacity)), _length(0), _flushed(0) {}
+
+BufferedWriter::BufferedWriter(std::string &output, const size_t capacity)
+	: _sink(&writeString), _destination(&output), _buffer(new char[bounded(capacity)]), _capacity(bounded(capacity)), _length(0), _flushed(0) {}
+
+BufferedWriter::BufferedWriter(const Sink sink, void *destination, const size_t capacity)
+	: _sink(sink), _destination(destination), _buffer(new char[bounded(capacity)]), _capacity(bounded(capacity)), _length(0), _flushed(0) {}
+
+/**
+ * @brief Destructor.
+ *
+ * Sends the remaining bytes to the destination before freeing the buffer.
+ */
+BufferedWriter::~BufferedWriter(void) {
+	flush();
+	delete[] _buffer;
+}
+
+/* ############################################################################################## */
+
+void BufferedWriter::flush(void) {
+	if (_length) {
+		_sink(_destination, _buffer, _length);
+		_flushed += _length;
+		_length	  = 0;
+	}
+}
+
+/**
+ * @brief Appends a block that does not fit in the remaining room.
+ *
+ * The buffer is flushed first; a block larger than the whole buffer is then sent as is.
+ */
+void BufferedWriter::appendSlow(const char *data, const size_t length) {
+	flush();
+	if (length > _capacity) {
+		_sink(_destination, data, length);
+		_flushed += length;
+	} else {
+		std::memcpy(_buffer, data, length);
+		_length = length;
+	}
+}
+
+void BufferedWriter::makeRoom(const size_t length) {
+	if (length > _capacity)
+		throw std::length_error("❌ The requested room exceeds the capacity of the BufferedWriter.");
+	flush();
+}
+
+/* ############################################################################################## */
+
+void BufferedWriter::writeStream(void *destination, const char *data, const size_t length) {
+	static_cast<std::ostream *>(destination)->write(data, static_cast<std::streamsize>(length));
+}
+
+void BufferedWriter::writeFile(void *destination, const char *data, const size_t length) {
+	std::fwrite(data, 1, length, static_cast<std::FILE *>(destination));
+}
+
+void BufferedWriter::writeString(void *destination, const char *data, const size_t length) {
+	static_cast<std::string *>(destination)->append(data, length);
+}
@@ -0,0 +1,135 @@
+#pragma once
+
+/* ############################################################################################## */
+
+/**
+ * @file BufferedWriter.hpp
+ * @brief Declaration of the BufferedWriter class, an output buffer flushed to a stream, a file or a string.
+ *
+ * Colorizers that emit many small pieces (a byte, an escape sequence) write them into a
+ * single buffer, which reaches the destination in large blocks:
+ * ```
+ * BufferedWriter output(std::cout);
+ * hexdump(packet, size, output);
+ * ```
+ * It also provides the `append()`, `reserve()` and `size()` members used by the ColorFormat
+ * append functions, so they can write into it directly.
+ *
+ * @author aheitz
+ * @date Created: 2026-10-17
+ * @date Last Modified: 2026-10-17
+ */
+
+/* ############################################################################################## */
+
+/*
+ * This file is part of the ColorFormat library.
+ *
+ * Copyright (C) 2025 aheitz <alexy.pa.heitz@gmail.com>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+/* ############################################################################################## */
+
+#include <cstddef>
+#include <cstdio>
+#include <cstring>
+#include <ostream>
+#include <string>
+
+/* ############################################################################################## */
+
+/**
+ * @brief Fixed-size output buffer in front of a destination.
+ *
+ * The buffer is flushed when it is full, on flush() and on destruction. Its capacity is at
+ * least minimumCapacity bytes, smaller ones being raised to it.
+ */
+class BufferedWriter {
+	public:
+		/** Receives the buffered bytes. */
+		typedef void (*Sink)(void *destination, const char *data, size_t length);
+
+		enum {
+			defaultCapacity = 1 << 16,
+			/** Room for the longest block acquired at once by the writers of this library, a HexDump line */
+			minimumCapacity = 1 << 12
+		};
+
+		explicit BufferedWriter(std::ostream &stream, size_t capacity = defaultCapacity);
+		explicit BufferedWriter(std::FILE *file, size_t capacity = defaultCapacity);
+		explicit BufferedWriter(std::string &output, size_t capacity = defaultCapacity);
+		BufferedWriter(Sink sink, void *destination, size_t capacity = defaultCapacity);
+		~BufferedWriter(void);
+
+		/** Copies bytes into the buffer; blocks larger than the buffer go straight to the destination. */
+		void append(const char *data, size_t length) {
+			if (length <= _capacity - _length) {
+				std::memcpy(_buffer + _length, data, length);
+				_length += length;
+			} else
+				appendSlow(data, length);
+		}
+
+		void append(const char character) {
+			if (_length == _capacity)
+				flush();
+			_buffer[_length++] = character;
+		}
+
+		/**
+		 * @brief Retrieves room for `length` contiguous bytes, flushing the buffer if needed.
+		 *
+		 * The bytes written there are kept by advance().
+		 *
+		 * @throws std::length_error if `length` exceeds the capacity of the buffer.
+		 */
+		char *acquire(const size_t length) {
+			if (length > _capacity - _length)
+				makeRoom(length);
+			return _buffer + _length;
+		}
+
+		/** Keeps the bytes written after acquire(). */
+		void advance(const size_t length) { _length += length; }
+
+		/** Sends the buffered bytes to the destination. */
+		void flush(void);
+
+		/** Retrieves the number of bytes written through the writer, flushed or not. */
+		size_t size(void) const { return _flushed + _length; }
+
+		/** Does nothing: the buffer has a fixed size. Present for the ColorFormat append functions. */
+		void reserve(size_t) {}
+
+		size_t capacity(void) const { return _capacity; }
+	private:
+		Sink	_sink;
+		void	*_destination;
+		char	*_buffer;
+		size_t	_capacity;
+		size_t	_length;
+		size_t	_flushed;
+
+		void appendSlow(const char *data, size_t length);
+		void makeRoom(size_t length);
+
+		static void writeStream(void *destination, const char *data, size_t length);
+		static void writeFile(void *destination, const char *data, size_t length);
+		static void writeString(void *destination, const char *data, size_t length);
+
+		BufferedWriter(const BufferedWriter &source);
+		BufferedWriter &operator=(const BufferedWriter &source);
+};
@@ -0,0 +1,379 @@
+#pragma once
+
+/* ############################################################################################## */
+
+/**
+ * @file ColorExpression.hpp
+ * @brief Declaration of the cf expressions, which build a styled line before writing it at once.
+ *
+ * Styled pieces are joined with `+` into a tree of views, without formatting anything:
+ * ```
+ * const std::string line = cf::red("a") + " " + cf::grad(n, 0, 100) + cf::bold(name);
+ * ```
+ * The tree is walked once to measure the exact output, then once to write it into a single
+ * allocation (or a caller buffer, a stream, any string type). Between two pieces, only the
+ * escape sequences changing the terminal state are written (ColorFormat::writeTransition()).
+ *
+ * The texts are referenced, not copied: an expression must not outlive them, which is the
+ * case when it is rendered in the statement that builds it. Temporary std::string texts are
+ * the exception, moved into the expression so that it can be kept:
+ * ```
+ * const auto label = cf::bold(std::string("id ") + std::to_string(id));	// owns its text
+ * const auto title = cf::red(name);										// name must outlive title
+ * ```
+ * The texts are written as they are, without removing their own escape sequences.
+ *
+ * Requires C++17.
+ *
+ * @author aheitz
+ * @date Created: 2026-10-17
+ * @date Last Modified: 2026-10-17
+ */
+
+/* ############################################################################################## */
+
+/*
+ * This file is part of the ColorFormat library.
+ *
+ * Copyright (C) 2025 aheitz <alexy.pa.heitz@gmail.com>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+/* ############################################################################################## */
+
+#include "ColorFormat.hpp"
+
+#include <cstring>
+#include <ostream>
+#include <string>
+#include <string_view>
+#include <utility>
+
+/* ############################################################################################## */
+
+namespace cf {
+
+/**
+ * @brief Common rendering of the expressions.
+ *
+ * `Derived` provides `render(sink, state)`, which appends its pieces to a sink
+ * (anything with `append(const char *, size_t)`) and updates the terminal state.
+ */
+template <typename Derived>
+class Expression {
+	private:
+		struct Counter {
+			size_t length;
+
+			void append(const char *, const size_t count) { length += count; }
+		};
+
+		struct Writer {
+			char *position;
+
+			void append(const char *text, const size_t count) { std::memcpy(position, text, count); position += count; }
+		};
+
+		struct StreamWriter {
+			std::ostream &stream;
+
+			void append(const char *text, const size_t count) { stream.write(text, static_cast<std::streamsize>(count)); }
+		};
+
+		/** Renders the whole expression, followed by a reset if a format is still applied. */
+		template <typename Sink>
+		void renderLine(Sink &sink) const {
+			ColorFormat::Attributes state = 0;
+
+			static_cast<const Derived &>(*this).render(sink, state);
+			if (state)
+				sink.append("\033[0m", 4);
+		}
+	public:
+		/** Computes the exact number of bytes written by the expression. */
+		size_t size(void) const {
+			Counter counter = {0};
+
+			renderLine(counter);
+			return counter.length;
+		}
+
+		/**
+		 * @brief Writes the expression into a buffer of at least size() bytes.
+		 * @return The end of the written bytes.
+		 */
+		char *write(char *buffer) const {
+			Writer writer = {buffer};
+
+			renderLine(writer);
+			return writer.position;
+		}
+
+		/** Appends the expression to any string type, after reserving its exact size. */
+		template <typename String>
+		String &appendTo(String &output) const {
+			output.reserve(output.size() + size());
+			renderLine(output);
+			return output;
+		}
+
+		std::string str(void) const {
+			std::string output;
+
+			appendTo(output);
+			return output;
+		}
+
+		operator std::string(void) const { return str(); }
+
+		friend std::ostream &operator<<(std::ostream &stream, const Expression &expression) {
+			StreamWriter writer = {stream};
+
+			expression.renderLine(writer);
+			return stream;
+		}
+};
+
+/* ############################################################################################## */
+
+/**
+ * @brief Styled piece of text, the leaf of the expressions.
+ */
+class Text : public Expression<Text> {
+	private:
+		/** Where the text is kept */
+		enum Storage { referencedText, ownedText, numberText };
+
+		const char				*_data;
+		size_t					_length;
+		ColorFormat::Attributes	_attributes;
+		char					_digits[ColorFormat::thousandsCapacity];	/**< Storage of a number, which has no text to reference */
+		std::string				_owned;										/**< Storage of a temporary string */
+		Storage					_storage;
+	public:
+		Text(const char *text, const ColorFormat::Attributes attributes = 0)
+			: _data(text), _length(std::strlen(text)), _attributes(attributes), _digits(), _storage(referencedText) {}
+		Text(const std::string &text, const ColorFormat::Attributes attributes = 0)
+			: _data(text.data()), _length(text.size()), _attributes(attributes), _digits(), _storage(referencedText) {}
+		Text(const std::string_view text, const ColorFormat::Attributes attributes = 0)
+			: _data(text.data()), _length(text.size()), _attributes(attributes), _digits(), _storage(referencedText) {}
+		/** Temporary string, moved into the text as it would not outlive the expression. */
+		Text(std::string &&text, const ColorFormat::Attributes attributes = 0)
+			: _data(nullptr), _length(text.size()), _attributes(attributes), _digits(), _owned(std::move(text)), _storage(ownedText) {}
+
+		/** Number written with thousand separators, as ColorFormat::formatUnsignedInteger(). */
+		explicit Text(const unsigned int number, const ColorFormat::Attributes attributes = 0)
+			: _data(nullptr), _length(0), _attributes(attributes), _storage(numberText) {
+			_length = ColorFormat::writeThousands(number, _digits);
+		}
+
+		const char *data(void) const { return _storage == referencedText ? _data : _storage == ownedText ? _owned.data() : _digits; }
+		ColorFormat::Attributes attributes(void) const { return _attributes; }
+
+		/** Applies formats over the current ones (see ColorFormat::overlay()). */
+		Text with(const ColorFormat::Attributes attributes) const & {
+			Text text(*this);
+
+			text._attributes = ColorFormat::overlay(_attributes, attributes);
+			return text;
+		}
+
+		/** Same, moving an owned text instead of copying it. */
+		Text with(const ColorFormat::Attributes attributes) && {
+			_attributes = ColorFormat::overlay(_attributes, attributes);
+			return std::move(*this);
+		}
+
+		template <typename Sink>
+		void render(Sink &sink, ColorFormat::Attributes &state) const {
+			char transition[ColorFormat::transitionCapacity];
+
+			if (!_length)
+				return;
+			sink.append(transition, ColorFormat::writeTransition(state, _attributes, transition));
+			sink.append(data(), _length);
+			state = _attributes;
+		}
+};
+
+/**
+ * @brief Two expressions rendered one after the other.
+ */
+template <typename Left, typename Right>
+class Concatenation : public Expression<Concatenation<Left, Right> > {
+	private:
+		Left	_left;
+		Right	_right;
+	public:
+		/** Each side is copied from an lvalue and moved from an rvalue, so owned texts are moved down the tree. */
+		template <typename LeftSide, typename RightSide>
+		Concatenation(LeftSide &&left, RightSide &&right) : _left(std::forward<LeftSide>(left)), _right(std::forward<RightSide>(right)) {}
+
+		template <typename Sink>
+		void render(Sink &sink, ColorFormat::Attributes &state) const {
+			_left.render(sink, state);
+			_right.render(sink, state);
+		}
+};
+
+/* ############################################################################################## */
+
+/*
+ * Expressions given as rvalues, such as the result of a previous `+`, are moved into the new
+ * node instead of copied, so that building a chain of k pieces moves each piece k times at most
+ * and never copies an owned text.
+ */
+template <typename Left, typename Right>
+Concatenation<Left, Right> operator+(const Expression<Left> &left, const Expression<Right> &right) {
+	return Concatenation<Left, Right>(static_cast<const Left &>(left), static_cast<const Right &>(right));
+}
+
+template <typename Left, typename Right>
+Concatenation<Left, Right> operator+(Expression<Left> &&left, const Expression<Right> &right) {
+	return Concatenation<Left, Right>(static_cast<Left &&>(left), static_cast<const Right &>(right));
+}
+
+template <typename Left, typename Right>
+Concatenation<Left, Right> operator+(const Expression<Left> &left, Expression<Right> &&right) {
+	return Concatenation<Left, Right>(static_cast<const Left &>(left), static_cast<Right &&>(right));
+}
+
+template <typename Left, typename Right>
+Concatenation<Left, Right> operator+(Expression<Left> &&left, Expression<Right> &&right) {
+	return Concatenation<Left, Right>(static_cast<Left &&>(left), static_cast<Right &&>(right));
+}
+
+/** Plain texts can be joined on either side of an expression; temporary strings are moved into it. */
+template <typename Left>
+Concatenation<Left, Text> operator+(const Expression<Left> &left, const std::string_view right) {
+	return Concatenation<Left, Text>(static_cast<const Left &>(left), Text(right));
+}
+
+template <typename Left>
+Concatenation<Left, Text> operator+(Expression<Left> &&left, const std::string_view right) {
+	return Concatenation<Left, Text>(static_cast<Left &&>(left), Text(right));
+}
+
+template <typename Left>
+Concatenation<Left, Text> operator+(const Expression<Left> &left, const char *right) {
+	return Concatenation<Left, Text>(static_cast<const Left &>(left), Text(right));
+}
+
+template <typename Left>
+Concatenation<Left, Text> operator+(Expression<Left> &&left, const char *right) {
+	return Concatenation<Left, Text>(static_cast<Left &&>(left), Text(right));
+}
+
+template <typename Left>
+Concatenation<Left, Text> operator+(const Expression<Left> &left, std::string &&right) {
+	return Concatenation<Left, Text>(static_cast<const Left &>(left), Text(std::move(right)));
+}
+
+template <typename Left>
+Concatenation<Left, Text> operator+(Expression<Left> &&left, std::string &&right) {
+	return Concatenation<Left, Text>(static_cast<Left &&>(left), Text(std::move(right)));
+}
+
+template <typename Right>
+Concatenation<Text, Right> operator+(const std::string_view left, const Expression<Right> &right) {
+	return Concatenation<Text, Right>(Text(left), static_cast<const Right &>(right));
+}
+
+template <typename Right>
+Concatenation<Text, Right> operator+(const std::string_view left, Expression<Right> &&right) {
+	return Concatenation<Text, Right>(Text(left), static_cast<Right &&>(right));
+}
+
+template <typename Right>
+Concatenation<Text, Right> operator+(const char *left, const Expression<Right> &right) {
+	return Concatenation<Text, Right>(Text(left), static_cast<const Right &>(right));
+}
+
+template <typename Right>
+Concatenation<Text, Right> operator+(const char *left, Expression<Right> &&right) {
+	return Concatenation<Text, Right>(Text(left), static_cast<Right &&>(right));
+}
+
+template <typename Right>
+Concatenation<Text, Right> operator+(std::string &&left, const Expression<Right> &right) {
+	return Concatenation<Text, Right>(Text(std::move(left)), static_cast<const Right &>(right));
+}
+
+template <typename Right>
+Concatenation<Text, Right> operator+(std::string &&left, Expression<Right> &&right) {
+	return Concatenation<Text, Right>(Text(std::move(left)), static_cast<Right &&>(right));
+}
+
+/* ############################################################################################## */
+
+/** @name Pieces */
+/** @{ */
+inline Text style(Text text, const ColorFormat::Attributes attributes) { return std::move(text).with(attributes); }
+
+/** Number with thousand separators. */
+inline Text number(const unsigned int value, const ColorFormat::Attributes attributes = 0) { return Text(value, attributes); }
+
+/**
+ * @brief Number colored by its position in a range, as ColorFormat::formatGradientUnsignedInteger().
+ * @throws std::invalid_argument if the styles contain a foreground color.
+ */
+inline Text grad(const unsigned int value, const unsigned int minimum, const unsigned int maximum, const ColorFormat::Attributes styles = 0) {
+	const int colorIndex = ColorFormat::gradientColorIndex(value, minimum, maximum);
+
+	if (styles & ColorFormat::foregroundMask)
+		throw std::invalid_argument("❌ No color is authorized with the gradiation function.");
+	if (colorIndex == ColorFormat::gradientTooLow)
+		return Text(value, static_cast<ColorFormat::Attributes>(ColorFormat::red) | ColorFormat::blink | ColorFormat::bold);
+	if (colorIndex == ColorFormat::gradientTooHigh)
+		return Text(value, static_cast<ColorFormat::Attributes>(ColorFormat::green) | ColorFormat::blink | ColorFormat::bold);
+	return Text(value, ColorFormat::palette(static_cast<unsigned int>(colorIndex)) | styles);
+}
+/** @} */
+
+/** @name Colors */
+/** @{ */
+inline Text black(Text text)			{ return std::move(text).with(ColorFormat::black); }
+inline Text red(Text text)				{ return std::move(text).with(ColorFormat::red); }
+inline Text green(Text text)			{ return std::move(text).with(ColorFormat::green); }
+inline Text yellow(Text text)			{ return std::move(text).with(ColorFormat::yellow); }
+inline Text blue(Text text)				{ return std::move(text).with(ColorFormat::blue); }
+inline Text magenta(Text text)			{ return std::move(text).with(ColorFormat::magenta); }
+inline Text cyan(Text text)				{ return std::move(text).with(ColorFormat::cyan); }
+inline Text white(Text text)			{ return std::move(text).with(ColorFormat::white); }
+inline Text brightBlack(Text text)		{ return std::move(text).with(ColorFormat::brightBlack); }
+inline Text brightRed(Text text)		{ return std::move(text).with(ColorFormat::brightRed); }
+inline Text brightGreen(Text text)		{ return std::move(text).with(ColorFormat::brightGreen); }
+inline Text brightYellow(Text text)		{ return std::move(text).with(ColorFormat::brightYellow); }
+inline Text brightBlue(Text text)		{ return std::move(text).with(ColorFormat::brightBlue); }
+inline Text brightMagenta(Text text)	{ return std::move(text).with(ColorFormat::brightMagenta); }
+inline Text brightCyan(Text text)		{ return std::move(text).with(ColorFormat::brightCyan); }
+inline Text brightWhite(Text text)		{ return std::move(text).with(ColorFormat::brightWhite); }
+/** @} */
+
+/** @name Styles */
+/** @{ */
+inline Text bold(Text text)				{ return std::move(text).with(ColorFormat::bold); }
+inline Text underline(Text text)		{ return std::move(text).with(ColorFormat::underline); }
+inline Text italic(Text text)			{ return std::move(text).with(ColorFormat::italic); }
+inline Text strikethrough(Text text)	{ return std::move(text).with(ColorFormat::strikethrough); }
+inline Text blink(Text text)			{ return std::move(text).with(ColorFormat::blink); }
+inline Text dim(Text text)				{ return std::move(text).with(ColorFormat::dim); }
+inline Text inverse(Text text)			{ return std::move(text).with(ColorFormat::inverse); }
+inline Text hidden(Text text)			{ return std::move(text).with(ColorFormat::hidden); }
+inline Text doubleUnderline(Text text)	{ return std::move(text).with(ColorFormat::doubleUnderline); }
+inline Text overline(Text text)			{ return std::move(text).with(ColorFormat::overline); }
+/** @} */
+
+}
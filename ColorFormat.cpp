@@ -12,7 +12,7 @@
  * 
  * @author aheitz
  * @date Created: 2025-02-17
- * @date Last Modified: 2025-02-18
+ * @date Last Modified: 2026-10-17
  */
 
 /* ############################################################################################## */
@@ -39,29 +39,18 @@
 /* ############################################################################################## */
 
 /**
- * @brief ANSI color escape codes.
+ * @brief SGR parameters of the text styles.
  * 
- * This array stores the available text colors mapped to their corresponding ANSI escape codes.
- * Only one color can be applied at a time.
- */
-const std::string ColorFormat::_colors[8][2] = {
-	{"red",		"\033[31m"}, {"green", "\033[32m"},
-	{"yellow",	"\033[33m"}, {"blue",  "\033[34m"}, 
-	{"magenta", "\033[35m"}, {"cyan",  "\033[36m"},
-	{"white",	"\033[37m"}, {"black", "\033[30m"} };
-
-/**
- * @brief ANSI text style escape codes.
- * 
- * This array contains available text styles mapped to their ANSI escape codes.
+ * This array contains the codes of the styles, in the order of their bits in the attributes:
+ * bold, underline, italic, strikethrough, blink, dim, inverse, hidden, double underline and overline.
  * Multiple styles can be applied together.
  */
-const std::string ColorFormat::_styles[5][2] = {
-	{"bold",		  "\033[1m"},
-	{"underline",	  "\033[4m"},
-	{"italic",		  "\033[3m"},
-	{"strikethrough", "\033[9m"},
-	{"blink",		  "\033[5m"} };
+const unsigned char ColorFormat::_styleCodes[styleCount] = {1, 4, 3, 9, 5, 2, 7, 8, 21, 53};
+
+const ColorFormat::Attributes ColorFormat::styleMask;
+const ColorFormat::Attributes ColorFormat::foregroundMask;
+const ColorFormat::Attributes ColorFormat::backgroundMask;
+const ColorFormat::Attributes ColorFormat::unknownFormat;
 
 /* ############################################################################################## */
 
@@ -79,7 +68,32 @@ ColorFormat::ColorFormat(const std::string &string,
 	const std::string &secondFormat,
 	const std::string &thirdFormat,
 	const std::string &fourthFormat,
-	const std::string &fifthFormat) : _formattedString(formatString(string, firstFormat, secondFormat, thirdFormat, fourthFormat, fifthFormat)) {}
+	const std::string &fifthFormat) : _formattedString(formatString(string, firstFormat, secondFormat, thirdFormat, fourthFormat, fifthFormat)),
+									  _text(NULL), _length(0), _attributes(0) {}
+
+#if __cplusplus < 201703L
+/**
+ * @brief Constructs a ColorFormat object formatted on first use.
+ * @param string The text to be formatted, which must outlive the object until it is rendered.
+ * @param length The length of the text.
+ * @param attributes The formats to apply.
+ * @return ColorFormat The lazy object.
+ */
+ColorFormat ColorFormat::lazy(const char *string, const size_t length, const Attributes attributes) {
+	return ColorFormat(Lazy(), string, length, attributes);
+}
+
+ColorFormat ColorFormat::lazy(const char *string, const Attributes attributes) {
+	return ColorFormat(Lazy(), string, std::strlen(string), attributes);
+}
+
+ColorFormat ColorFormat::lazy(const std::string &string, const Attributes attributes) {
+	return ColorFormat(Lazy(), string.data(), string.size(), attributes);
+}
+#endif
+
+ColorFormat::ColorFormat(Lazy, const char *text, const size_t length, const Attributes attributes)
+	: _formattedString(), _text(text), _length(length), _attributes(attributes) {}
 
 /**
  * @brief Copy constructor.
@@ -87,7 +101,8 @@ ColorFormat::ColorFormat(const std::string &string,
  * Creates a new `ColorFormat` object as an exact copy of another.
  * @param source The ColorFormat object to copy from.
  */
-ColorFormat::ColorFormat(const ColorFormat &source) : _formattedString(source._formattedString) {}
+ColorFormat::ColorFormat(const ColorFormat &source)
+	: _formattedString(source._formattedString), _text(source._text), _length(source._length), _attributes(source._attributes) {}
 
 /**
  * @brief Assignment operator.
@@ -99,8 +114,12 @@ ColorFormat::ColorFormat(const ColorFormat &source) : _formattedString(source._f
  * @return Reference to this object.
  */
 ColorFormat &ColorFormat::operator=(const ColorFormat &source) {
-	if (this != &source)
+	if (this != &source) {
 		_formattedString = source._formattedString;
+		_text			 = source._text;
+		_length			 = source._length;
+		_attributes		 = source._attributes;
+	}
 	return *this;
 }
 
@@ -114,36 +133,379 @@ ColorFormat::~ColorFormat(void) {}
 /* ############################################################################################## */
 
 /**
- * @brief Removes all ANSI formatting codes from the given string.
+ * @brief Retrieves the formatted string.
  * 
- * This function detects and removes ANSI escape sequences (e.g., colors, styles)
- * from the provided text, ensuring a clean, unformatted string.
+ * This function returns the string that has been formatted with the selected
+ * color and/or styles.
  * 
- * @param string The string to clean from previous formatting.
+ * @return std::string The formatted string with ANSI escape sequences.
  */
-void ColorFormat::removePreviousFormats(std::string &string) {
-	size_t start = 0;
+const std::string ColorFormat::getFormattedString(void) const { return rendered(); }
 
-	while ((start = string.find("\033[")) != std::string::npos) {
-		size_t end = string.find('m', start);
-		if (end != std::string::npos)
-			string.erase(start, end - start + 1);
-		else
-			break;
+const std::string &ColorFormat::rendered(void) const {
+	if (_text) {
+		appendFormatted(_formattedString, _text, _length, _attributes);
+		_text = NULL;
 	}
+	return _formattedString;
 }
 
-/* ############################################################################################## */
+/**
+ * @brief Writes the formatted string of a ColorFormat object to a stream.
+ * 
+ * @param stream The output stream.
+ * @param format The object to write, rendered first if it is lazy.
+ * @return std::ostream& The stream.
+ */
+std::ostream &operator<<(std::ostream &stream, const ColorFormat &format) {
+	const std::string &formatted = format.rendered();
+
+	return stream.write(formatted.data(), static_cast<std::streamsize>(formatted.size()));
+}
 
 /**
- * @brief Retrieves the formatted string.
+ * @brief Adds one named format to a set of attributes.
  * 
- * This function returns the string that has been formatted with the selected
- * color and/or styles.
+ * @param attributes The attributes already selected.
+ * @param format The name of the format to add (e.g., "bold", "red"), not necessarily null-terminated.
+ * @param length The length of the name. Empty names are ignored.
+ * @return The attributes including the new format.
  * 
- * @return std::string The formatted string with ANSI escape sequences.
+ * @throws std::invalid_argument If a second color, a duplicate style or an unknown format is detected.
+ */
+ColorFormat::Attributes ColorFormat::mergeFormat(const Attributes attributes, const char *format, const size_t length) {
+	if (!length)
+		return attributes;
+
+	const Attributes added = resolveFormat(format, length);
+	if (added == unknownFormat)
+		throw std::invalid_argument("❌ Unknown format detected: " + std::string(format, length));
+	return mergeFormat(attributes, added);
+}
+
+ColorFormat::Attributes ColorFormat::mergeFormat(const Attributes attributes, const std::string &format) {
+	return mergeFormat(attributes, format.data(), format.size());
+}
+
+ColorFormat::Attributes ColorFormat::mergeFormat(const Attributes attributes, const char *format) {
+	return mergeFormat(attributes, format, std::strlen(format));
+}
+
+#if __cplusplus >= 201703L
+ColorFormat::Attributes ColorFormat::mergeFormat(const Attributes attributes, const std::string_view format) {
+	return mergeFormat(attributes, format.data(), format.size());
+}
+#endif
+
+/**
+ * @brief Adds resolved formats to a set of attributes.
+ * 
+ * @param attributes The attributes already selected.
+ * @param format The colors and styles to add (e.g., a ColorFormat::Format value).
+ * @return The attributes including the new formats.
+ * 
+ * @throws std::invalid_argument If a second color or a duplicate style is detected.
+ */
+ColorFormat::Attributes ColorFormat::mergeFormat(const Attributes attributes, const Attributes format) {
+	const Attributes duplicates = attributes & format & styleMask;
+
+	if ((attributes >> foregroundKindShift & 3) and (format >> foregroundKindShift & 3))
+		throw std::invalid_argument("❌ Multiple colors detected. Only one is allowed.");
+	if ((attributes >> backgroundKindShift & 3) and (format >> backgroundKindShift & 3))
+		throw std::invalid_argument("❌ Multiple background colors detected. Only one is allowed.");
+	if (duplicates)
+		throw std::invalid_argument(std::string("❌ Duplicate style detected: ") + formatName(duplicates & (~duplicates + 1)) + '.');
+	return attributes | format;
+}
+
+/**
+ * @brief Writes a decimal SGR parameter.
+ * 
+ * @param buffer The destination.
+ * @param number The parameter, below 1000.
+ * @return char* The end of the written digits.
+ */
+static char *writeParameter(char *buffer, const unsigned int number) {
+	if (number >= 100)
+		*buffer++ = static_cast<char>('0' + number / 100);
+	if (number >= 10)
+		*buffer++ = static_cast<char>('0' + number / 10 % 10);
+	*buffer++ = static_cast<char>('0' + number % 10);
+	return buffer;
+}
+
+/**
+ * @brief Writes the escape sequence of a color.
+ * 
+ * @param buffer The destination.
+ * @param kind The ColorKind of the color (nothing is written for noColor).
+ * @param value The 16-color index, 256-color index or 0xRRGGBB value.
+ * @param base 30 for a foreground color, 40 for a background color.
+ * @return char* The end of the written sequence.
+ */
+char *ColorFormat::writeColor(char *buffer, const unsigned int kind, const unsigned int value, const unsigned int base) {
+	if (kind == noColor)
+		return buffer;
+
+	*buffer++ = '\033';
+	*buffer++ = '[';
+	buffer	  = writeColorParameters(buffer, kind, value, base);
+	*buffer++ = 'm';
+	return buffer;
+}
+
+/**
+ * @brief Writes the SGR parameters of a color, without the sequence around them.
+ * 
+ * @param buffer The destination.
+ * @param kind The ColorKind of the color, other than noColor.
+ * @param value The 16-color index, 256-color index or 0xRRGGBB value.
+ * @param base 30 for a foreground color, 40 for a background color.
+ * @return char* The end of the written parameters.
+ */
+char *ColorFormat::writeColorParameters(char *buffer, const unsigned int kind, const unsigned int value, const unsigned int base) {
+	if (kind == basicColor)
+		buffer = writeParameter(buffer, value < 8 ? base + value : base + 60 + value - 8);
+	else {
+		buffer	  = writeParameter(buffer, base + 8);
+		*buffer++ = ';';
+		*buffer++ = kind == paletteColor ? '5' : '2';
+		*buffer++ = ';';
+		if (kind == paletteColor)
+			buffer = writeParameter(buffer, value);
+		else {
+			buffer	  = writeParameter(buffer, value >> 16);
+			*buffer++ = ';';
+			buffer	  = writeParameter(buffer, value >> 8 & 0xFF);
+			*buffer++ = ';';
+			buffer	  = writeParameter(buffer, value & 0xFF);
+		}
+	}
+	return buffer;
+}
+
+/**
+ * @brief Writes the escape prefix of a set of attributes.
+ * 
+ * The foreground color comes first, followed by the background color and the styles,
+ * each in its own escape sequence.
+ * 
+ * @param attributes The attributes whose prefix is wanted.
+ * @param buffer The destination, of at least prefixCapacity bytes.
+ * @return size_t The number of bytes written.
+ */
+size_t ColorFormat::writePrefix(const Attributes attributes, char *buffer) {
+	char *position = buffer;
+
+	position = writeColor(position, attributes >> foregroundKindShift & 3, attributes >> foregroundShift & 0xFFFFFF, 30);
+	position = writeColor(position, attributes >> backgroundKindShift & 3, attributes >> backgroundShift & 0xFFFFFF, 40);
+	for (size_t i = 0 ; i < styleCount ; i++)
+		if (attributes & static_cast<Attributes>(1) << i) {
+			*position++ = '\033';
+			*position++ = '[';
+			position	= writeParameter(position, _styleCodes[i]);
+			*position++ = 'm';
+		}
+	return position - buffer;
+}
+
+/**
+ * @brief Retrieves the escape prefix of a set of attributes.
+ * 
+ * @param attributes The attributes whose prefix is wanted.
+ * @return std::string The color escape codes followed by the style escape codes.
  */
-const std::string ColorFormat::getFormattedString(void) const { return _formattedString; }
+std::string ColorFormat::prefix(const Attributes attributes) {
+	char buffer[prefixCapacity];
+
+	return std::string(buffer, writePrefix(attributes, buffer));
+}
+
+/**
+ * @brief Writes the shortest escape sequences that switch the terminal from a set of attributes to another.
+ * 
+ * Added styles and replaced colors are written alone. Removing a style or a color
+ * requires a reset, followed by the whole prefix of the new attributes.
+ * 
+ * @param from The attributes currently applied.
+ * @param to The attributes to apply.
+ * @param buffer The destination, of at least transitionCapacity bytes.
+ * @return size_t The number of bytes written (0 if both sets are equal).
+ */
+size_t ColorFormat::writeTransition(const Attributes from, const Attributes to, char *buffer) {
+	if (from == to)
+		return 0;
+
+	const bool removed = (from & styleMask & ~to)
+					  or ((from >> foregroundKindShift & 3) and !(to >> foregroundKindShift & 3))
+					  or ((from >> backgroundKindShift & 3) and !(to >> backgroundKindShift & 3));
+	if (removed or !to) {
+		std::memcpy(buffer, "\033[0m", 4);
+		return 4 + writePrefix(to, buffer + 4);
+	}
+
+	Attributes changed = to & styleMask & ~from;
+	if ((to & foregroundMask) != (from & foregroundMask))
+		changed |= to & foregroundMask;
+	if ((to & backgroundMask) != (from & backgroundMask))
+		changed |= to & backgroundMask;
+	return writePrefix(changed, buffer);
+}
+
+/**
+ * @brief Writes the escape sequence that turns some attributes into others, parameter by parameter.
+ * 
+ * Removed styles are turned off with their reset codes; as bold and dim share `22`, and
+ * underline and double underline share `24`, a style of the same pair that is kept is
+ * turned on again after it. Removed colors are reset with `39` and `49`. When a reset
+ * followed by all the wanted attributes is shorter, it is written instead.
+ * 
+ * @param from The current attributes of the terminal.
+ * @param to The wanted attributes.
+ * @param buffer The destination, of at least deltaCapacity bytes.
+ * @return size_t The number of bytes written.
+ */
+size_t ColorFormat::writeDelta(const Attributes from, const Attributes to, char *buffer) {
+	static const unsigned char offCodes[styleCount] = {22, 24, 23, 29, 25, 22, 27, 28, 24, 55};
+	char					   *position			= buffer + 2;
+	Attributes				   kept					= from & styleMask & to;
+
+	if (from == to)
+		return 0;
+	if (!to) {
+		std::memcpy(buffer, "\033[0m", 4);
+		return 4;
+	}
+
+	/* A shared reset code also turns off the other style of its pair */
+	const Attributes removed = from & styleMask & ~to;
+	if (removed & (bold | dim))
+		kept &= ~static_cast<Attributes>(bold | dim);
+	if (removed & (underline | doubleUnderline))
+		kept &= ~static_cast<Attributes>(underline | doubleUnderline);
+
+	unsigned int written = 0;	/* off codes already written, by their index in offCodes */
+	for (size_t i = 0 ; i < styleCount ; i++)
+		if (removed & static_cast<Attributes>(1) << i) {
+			const size_t first = offCodes[i] == 22 ? 0 : offCodes[i] == 24 ? 1 : i;
+			if (written & 1u << first)
+				continue;
+			written	   |= 1u << first;
+			position	= writeParameter(position, offCodes[i]);
+			*position++ = ';';
+		}
+
+	const unsigned int toForeground = static_cast<unsigned int>(to >> foregroundKindShift & 3);
+	if ((from & foregroundMask) != (to & foregroundMask)) {
+		position	= toForeground ? writeColorParameters(position, toForeground, to >> foregroundShift & 0xFFFFFF, 30)
+								   : writeParameter(position, 39);
+		*position++ = ';';
+	}
+	const unsigned int toBackground = static_cast<unsigned int>(to >> backgroundKindShift & 3);
+	if ((from & backgroundMask) != (to & backgroundMask)) {
+		position	= toBackground ? writeColorParameters(position, toBackground, to >> backgroundShift & 0xFFFFFF, 40)
+								   : writeParameter(position, 49);
+		*position++ = ';';
+	}
+
+	const Attributes added = to & styleMask & ~kept;
+	for (size_t i = 0 ; i < styleCount ; i++)
+		if (added & static_cast<Attributes>(1) << i) {
+			position	= writeParameter(position, _styleCodes[i]);
+			*position++ = ';';
+		}
+
+	buffer[0]	 = '\033';
+	buffer[1]	 = '[';
+	position[-1] = 'm';
+
+	const size_t length = static_cast<size_t>(position - buffer);
+
+	/* Turning many attributes off can take longer than a reset followed by the wanted ones */
+	if (removed or ((from & foregroundMask) and not toForeground) or ((from & backgroundMask) and not toBackground)) {
+		char		 reset[deltaCapacity];
+		const size_t resetLength = writeDelta(0, to, reset) + 2;
+
+		if (resetLength < length) {
+			std::memcpy(buffer, "\033[0;", 4);
+			std::memcpy(buffer + 4, reset + 2, resetLength - 4);
+			return resetLength;
+		}
+	}
+	return length;
+}
+
+/**
+ * @brief Applies the parameters of an SGR sequence to a terminal state.
+ * 
+ * @param state The attributes of the terminal before the sequence.
+ * @param parameters The parameters, separated by semicolons; empty ones stand for 0.
+ * @param length The length of the parameters.
+ * @param base The attributes restored by a reset.
+ * @return Attributes The attributes of the terminal after the sequence.
+ */
+ColorFormat::Attributes ColorFormat::applyParameters(Attributes state, const char *parameters, const size_t length, const Attributes base) {
+	unsigned int values[32];
+	size_t		 count = 0;
+	size_t		 i	   = 0;
+
+	/* Parameters beyond the 32 first ones are ignored */
+	do {
+		unsigned int value = 0;
+		while (i < length and parameters[i] >= '0' and parameters[i] <= '9') {
+			if (value < 100000)
+				value = value * 10 + static_cast<unsigned int>(parameters[i] - '0');
+			++i;
+		}
+		if (count < 32)
+			values[count++] = value;
+	} while (i < length and parameters[i++] == ';');
+
+	for (size_t index = 0 ; index < count ; index++) {
+		const unsigned int value = values[index];
+
+		if (value == 0)
+			state = base;
+		else if (value == 22)
+			state &= ~static_cast<Attributes>(bold | dim);
+		else if (value == 24)
+			state &= ~static_cast<Attributes>(underline | doubleUnderline);
+		else if (value == 23 or value == 25 or value == 27 or value == 28 or value == 29 or value == 55) {
+			const Attributes style = value == 23 ? italic : value == 25 ? blink : value == 27 ? inverse
+								   : value == 28 ? hidden : value == 29 ? strikethrough : overline;
+			state &= ~style;
+		}
+		else if ((value >= 30 and value <= 37) or (value >= 90 and value <= 97))
+			state = (state & ~foregroundMask) | static_cast<Attributes>(basicColor) << foregroundKindShift
+				  | static_cast<Attributes>(value >= 90 ? value - 82 : value - 30) << foregroundShift;
+		else if ((value >= 40 and value <= 47) or (value >= 100 and value <= 107))
+			state = (state & ~backgroundMask) | static_cast<Attributes>(basicColor) << backgroundKindShift
+				  | static_cast<Attributes>(value >= 100 ? value - 92 : value - 40) << backgroundShift;
+		else if (value == 39)
+			state &= ~foregroundMask;
+		else if (value == 49)
+			state &= ~backgroundMask;
+		else if (value == 38 or value == 48) {
+			Attributes color = unknownFormat;
+			if (index + 2 < count and values[index + 1] == 5) {
+				color  = palette(values[index + 2]);
+				index += 2;
+			} else if (index + 4 < count and values[index + 1] == 2) {
+				color  = rgb(values[index + 2], values[index + 3], values[index + 4]);
+				index += 4;
+			} else
+				break;	/* the rest of the sequence cannot be told apart from the color */
+			if (value == 38)
+				state = (state & ~foregroundMask) | color;
+			else
+				state = (state & ~backgroundMask) | background(color);
+		} else
+			for (size_t style = 0 ; style < styleCount ; style++)
+				if (_styleCodes[style] == value)
+					state |= static_cast<Attributes>(1) << style;
+	}
+	return state;
+}
 
 /**
  * @brief Formats a string with specified styles and colors.
@@ -170,46 +532,56 @@ const std::string ColorFormat::formatString(std::string string,
 											const std::string &fourthFormat,
 											const std::string &fifthFormat,
 											const std::string &sixthFormat) {
-	std::string color			= "";
-	std::string formats			= "";
-	std::string parameters[6]	= {firstFormat, secondFormat, thirdFormat, fourthFormat, fifthFormat, sixthFormat};
-	bool		activeStyles[5] = {false};
+	const std::string *parameters[6] = {&firstFormat, &secondFormat, &thirdFormat, &fourthFormat, &fifthFormat, &sixthFormat};
+	Attributes		  attributes	= 0;
+
+	std::string		  result;
 
 	if (string.empty())
-		return "";
+		return result;
 
-	for (size_t i = 0 ; i < 6 ; i++) {
-		bool done = parameters[i].empty() ? true : false;
-		if (!done) {
-			for (size_t j = 0 ; j < 8 ; j++) {
-				if (parameters[i] == _colors[j][0]) {
-					if (!color.empty())
-						throw std::invalid_argument("❌ Multiple colors detected. Only one is allowed.");
-					color = _colors[j][1];
-					done = true;
-					break;
-				}
-			}
-			if (!done) {
-				for (size_t j = 0 ; j < 5 ; j++)
-					if (parameters[i] == _styles[j][0]) {
-						if (activeStyles[j])
-							throw std::invalid_argument("❌ Duplicate style detected: " + parameters[i] + '.');
-						activeStyles[j] = true;
-						formats += _styles[j][1];
-						done = true;
-						break;
-					}
-			}
-			if (!done)
-				throw std::invalid_argument("❌ Unknown format detected: " + parameters[i]);
-		}
-	}
+	for (size_t i = 0 ; i < 6 ; i++)
+		attributes = mergeFormat(attributes, *parameters[i]);
 
-	if (!color.empty() or !formats.empty())
-		removePreviousFormats(string);
+	appendFormatted(result, string.data(), string.size(), attributes);
+	return result;
+}
 
-	return color + formats + string + "\033[0m";
+/**
+ * @brief Formats a wide string with specified styles and colors.
+ * 
+ * The escape sequences are written as wide characters, so the text is never converted.
+ * 
+ * @param string The text to format.
+ * @param firstFormat The first formatting option (e.g., "bold", "red").
+ * @param secondFormat The second formatting option (optional).
+ * @param thirdFormat The third formatting option (optional).
+ * @param fourthFormat The fourth formatting option (optional).
+ * @param fifthFormat The fifth formatting option (optional).
+ * @param sixthFormat The sixth formatting option (optional).
+ * @return std::wstring The formatted string with ANSI escape sequences.
+ * 
+ * @throws std::invalid_argument If multiple colors or unknown formats are detected.
+ */
+const std::wstring ColorFormat::formatString(const std::wstring &string,
+											 const std::string &firstFormat,
+											 const std::string &secondFormat,
+											 const std::string &thirdFormat,
+											 const std::string &fourthFormat,
+											 const std::string &fifthFormat,
+											 const std::string &sixthFormat) {
+	const std::string *parameters[6] = {&firstFormat, &secondFormat, &thirdFormat, &fourthFormat, &fifthFormat, &sixthFormat};
+	Attributes		  attributes	= 0;
+	std::wstring	  result;
+
+	if (string.empty())
+		return result;
+
+	for (size_t i = 0 ; i < 6 ; i++)
+		attributes = mergeFormat(attributes, *parameters[i]);
+
+	appendFormatted(result, string.data(), string.size(), attributes);
+	return result;
 }
 
 /**
@@ -233,19 +605,193 @@ const std::string ColorFormat::formatUnsignedInteger(unsigned int number,
 													 const std::string &fourthFormat,
 													 const std::string &fifthFormat,
 													 const std::string &sixthFormat) {
-	std::string formattedUnsignedInteger = "";
-	size_t		commaCount = 0;
+	char digits[thousandsCapacity];
+
+	return formatString(std::string(digits, writeThousands(number, digits)), firstFormat, secondFormat, thirdFormat, fourthFormat, fifthFormat, sixthFormat);
+}
+
+/**
+ * @brief Writes an unsigned integer with a comma every three digits.
+ * 
+ * @param number The unsigned integer to write.
+ * @param buffer The destination, of at least thousandsCapacity bytes.
+ * @return size_t The number of bytes written.
+ */
+size_t ColorFormat::writeThousands(unsigned int number, char *buffer) {
+	char		 digits[thousandsCapacity];
+	char		 *position	= digits + thousandsCapacity;
+	unsigned int digitCount = 0;
 
 	do {
-		if (!formattedUnsignedInteger.empty() and !((formattedUnsignedInteger.size() - commaCount) % 3)) {
-			formattedUnsignedInteger.insert(0, ",");
-			++commaCount;
-		}
-		formattedUnsignedInteger.insert(0, 1, static_cast<char>('0' + number % 10));
+		if (digitCount and !(digitCount % 3))
+			*--position = ',';
+		*--position = static_cast<char>('0' + number % 10);
 		number /= 10;
+		++digitCount;
 	} while (number);
 
-	return formatString(formattedUnsignedInteger, firstFormat, secondFormat, thirdFormat, fourthFormat, fifthFormat, sixthFormat);
+	const size_t length = static_cast<size_t>(digits + thousandsCapacity - position);
+	std::memcpy(buffer, position, length);
+	return length;
+}
+
+/**
+ * @brief Counts the decimal digits of a number.
+ * 
+ * The number of bits gives the number of digits up to one (bits * log10(2), with
+ * log10(2) ~ 1233 / 4096), which a comparison with the matching power of ten settles.
+ * 
+ * @param number The number.
+ * @return size_t The number of digits, 1 for 0.
+ */
+size_t ColorFormat::digitCount(const unsigned int number) {
+	static const uint32_t powers[10] = {0, 10, 100, 1000, 10000, 100000, 1000000, 10000000, 100000000, 1000000000};
+
+#ifdef __GNUC__
+	const unsigned int bits = 32 - static_cast<unsigned int>(__builtin_clz(number | 1));
+#else
+	unsigned int bits = 1;
+	while (bits < 32 and number >> bits)
+		++bits;
+#endif
+	const unsigned int guess = bits * 1233 >> 12;
+	return guess + 1 - (number < powers[guess]);
+}
+
+/**
+ * @brief Computes the length of a number written with a comma every three digits.
+ * 
+ * @param number The number.
+ * @return size_t The length of the output of writeThousands().
+ */
+size_t ColorFormat::thousandsSize(const unsigned int number) {
+	const size_t digits = digitCount(number);
+
+	return digits + (digits - 1) / 3;
+}
+
+/**
+ * @brief Computes the length of the escape sequence of a color, without writing it.
+ * 
+ * @param kind The ColorKind of the color.
+ * @param value The 16-color index, 256-color index or 0xRRGGBB value.
+ * @param base 30 for a foreground color, 40 for a background color.
+ * @return size_t The length of the output of writeColor().
+ */
+static size_t colorSize(const unsigned int kind, const unsigned int value, const unsigned int base) {
+	if (kind == ColorFormat::noColor)
+		return 0;
+	if (kind == ColorFormat::basicColor)
+		return 3 + (value >= 8 and base == 40 ? 3 : 2);
+	if (kind == ColorFormat::paletteColor)
+		return 8 + ColorFormat::digitCount(value);
+	return 10 + ColorFormat::digitCount(value >> 16) + ColorFormat::digitCount(value >> 8 & 0xFF) + ColorFormat::digitCount(value & 0xFF);
+}
+
+/**
+ * @brief Computes the length of the escape prefix of a set of attributes, without writing it.
+ * 
+ * @param attributes The attributes.
+ * @return size_t The length of the output of writePrefix().
+ */
+size_t ColorFormat::prefixSize(const Attributes attributes) {
+	size_t size = colorSize(static_cast<unsigned int>(attributes >> foregroundKindShift & 3),
+							static_cast<unsigned int>(attributes >> foregroundShift & 0xFFFFFF), 30)
+				+ colorSize(static_cast<unsigned int>(attributes >> backgroundKindShift & 3),
+							static_cast<unsigned int>(attributes >> backgroundShift & 0xFFFFFF), 40);
+
+	for (size_t i = 0 ; i < styleCount ; i++)
+		if (attributes & static_cast<Attributes>(1) << i)
+			size += _styleCodes[i] >= 10 ? 5 : 4;
+	return size;
+}
+
+/**
+ * @brief Computes the length of a formatted text, without formatting it.
+ * 
+ * Only the previous formats of the text, removed when attributes are given, require
+ * going through it.
+ * 
+ * @param text The text.
+ * @param length The length of the text.
+ * @param attributes The formats applied to the text.
+ * @return size_t The length of the output of appendFormatted().
+ */
+size_t ColorFormat::formattedSize(const char *text, const size_t length, const Attributes attributes) {
+	size_t removed = 0;
+
+	if (!length)
+		return 0;
+	for (size_t i = 0 ; attributes and i + 1 < length ; ) {
+		if (text[i] == '\033' and text[i + 1] == '[') {
+			const char *end = static_cast<const char *>(std::memchr(text + i, 'm', length - i));
+			if (!end)
+				break;
+			removed += static_cast<size_t>(end - text) + 1 - i;
+			i		 = static_cast<size_t>(end - text) + 1;
+		} else
+			++i;
+	}
+	return prefixSize(attributes) + length - removed + 4;
+}
+
+/**
+ * @brief Computes the length of a formatted number.
+ * 
+ * @param number The number.
+ * @param attributes The formats applied to the number.
+ * @return size_t The length of the output of formatUnsignedInteger().
+ */
+size_t ColorFormat::formattedUnsignedIntegerSize(const unsigned int number, const Attributes attributes) {
+	return prefixSize(attributes) + thousandsSize(number) + 4;
+}
+
+/**
+ * @brief Computes the length of a number colored by its position in a range.
+ * 
+ * @param number The number.
+ * @param minimum The lower bound of the gradient.
+ * @param maximum The upper bound of the gradient.
+ * @param attributes The styles applied to the number, replaced when it is out of range.
+ * @return size_t The length of the output of formatGradientUnsignedInteger().
+ */
+size_t ColorFormat::formattedGradientSize(const unsigned int number, const unsigned int minimum, const unsigned int maximum,
+										  const Attributes attributes) {
+	const int colorIndex = gradientColorIndex(number, minimum, maximum);
+
+	/* Blinking red or green, whose sequences have the same length */
+	if (colorIndex == gradientTooLow or colorIndex == gradientTooHigh)
+		return formattedUnsignedIntegerSize(number, static_cast<Attributes>(red) | blink | bold);
+	return prefixSize(palette(static_cast<unsigned int>(colorIndex))) + formattedUnsignedIntegerSize(number, attributes) + 4;
+}
+
+/**
+ * @brief Computes the length of a rainbow-colored text.
+ * 
+ * Every character takes a 5-byte color sequence; the previous formats of the text are removed.
+ * 
+ * @param text The text.
+ * @param length The length of the text.
+ * @param styles The styles applied to the whole text.
+ * @return size_t The length of the output of rainbow().
+ */
+size_t ColorFormat::formattedRainbowSize(const char *text, const size_t length, const Attributes styles) {
+	size_t size = prefixSize(styles) + 4;
+
+	if (!length)
+		return std::strlen("🌈");
+	for (size_t i = 0 ; i < length ; i++) {
+		if (text[i] == '\033' and i + 1 < length and text[i + 1] == '[') {
+			const char *end = static_cast<const char *>(std::memchr(text + i, 'm', length - i));
+			if (end) {
+				i = static_cast<size_t>(end - text);
+				continue;
+			}
+			return size + length - i + 1;
+		}
+		size += 6;
+	}
+	return size;
 }
 
 /**
@@ -276,20 +822,43 @@ const std::string ColorFormat::formatGradientUnsignedInteger(const unsigned int
 															 const std::string &thirdFormat,
 															 const std::string &fourthFormat,
 															 const std::string &fifthFormat) {
-	std::string parameters[5] = {firstFormat, secondFormat, thirdFormat, fourthFormat, fifthFormat};
+	const std::string *parameters[5] = {&firstFormat, &secondFormat, &thirdFormat, &fourthFormat, &fifthFormat};
+	for (size_t i = 0 ; i < 5 ; i++)
+		if (!parameters[i]->empty()) {
+			const Attributes attributes = resolveFormat(parameters[i]->data(), parameters[i]->size());
+			if (attributes != unknownFormat and attributes & foregroundMask)
+				throw std::invalid_argument("❌ No color is aurotized with the gradiation function.");
+		}
+
+	Attributes attributes = 0;
 	for (size_t i = 0 ; i < 5 ; i++)
-		if (!parameters[i].empty())
-			for (size_t j = 0 ; j < 8 ; j++)
-				if (parameters[i] == _colors[j][0])
-					throw std::invalid_argument("❌ No color is aurotized with the gradiation function.");
+		attributes = mergeFormat(attributes, *parameters[i]);
 
+	std::string result;
+	appendGradient(result, number, minimum, maximum, attributes);
+	return result;
+}
+
+/**
+ * @brief Computes the gradient color of a number within a range.
+ * 
+ * The color goes from red (ratio 0) to green (ratio 1) through yellow, and is
+ * approximated in the 6x6x6 cube of the 256-color palette.
+ * If `minimum > maximum`, the gradient is reversed.
+ * 
+ * @param number The value to locate in the range.
+ * @param minimum The lower bound of the gradient.
+ * @param maximum The upper bound of the gradient.
+ * @return int The 256-color index, or gradientTooLow / gradientTooHigh if the number is out of range.
+ */
+int ColorFormat::gradientColorIndex(const unsigned int number, const unsigned int minimum, const unsigned int maximum) {
 	if ((number <  minimum and minimum <  maximum) or
 		(number >  minimum and minimum >  maximum) or
 		(number != maximum and minimum == maximum))
-		return formatUnsignedInteger(number, "red", "blink", "bold");
+		return gradientTooLow;
 	if ((number > maximum and maximum > minimum) or
 		(number < maximum and maximum < minimum))
-		return formatUnsignedInteger(number, "green", "blink", "bold");
+		return gradientTooHigh;
 
 	const bool	 reversed = minimum > maximum;
 	const double progress = reversed ? (double)(number  - maximum) : (double)(number  - minimum);
@@ -304,9 +873,7 @@ const std::string ColorFormat::formatGradientUnsignedInteger(const unsigned int
 	int green = (ratio < 0.5) ? (int)(255 * ratio * 2) : 255;
 	int blue  = 0;
 
-	std::ostringstream color;
-	color << "\033[38;5;" << 16 + (red / 51) * 36 + (green / 51) * 6 + (blue / 51) << "m";
-	return color.str() + formatUnsignedInteger(number, firstFormat, secondFormat, thirdFormat, fourthFormat, fifthFormat) + "\033[0m";
+	return 16 + (red / 51) * 36 + (green / 51) * 6 + (blue / 51);
 }
 
 /**
@@ -329,48 +896,167 @@ const std::string ColorFormat::rainbow(const std::string &firstArgument,
 									   const std::string &thirdArgument,
 									   const std::string &fourthArgument,
 									   const std::string &fifthArgument) {
-	std::string string		 = "";
-	std::string format		 = "";
-	std::string arguments[5] = {firstArgument, secondArgument, thirdArgument, fourthArgument, fifthArgument};
+	const std::string *text			= NULL;
+	Attributes		  styles		= 0;
+	const std::string *arguments[5] = {&firstArgument, &secondArgument, &thirdArgument, &fourthArgument, &fifthArgument};
 	for (size_t i = 0 ; i < 5 ; i++) {
-		if (!arguments[i].empty()) {
-			for (size_t j = 0 ; j < 5 ; j++) {
-				if (arguments[i] == _styles[j][0]) {
-					format += _styles[j][1];
-					arguments[i] = "";
-					break;
-				}
-			}
-			if (!arguments[i].empty())
-				(string.empty()) ? string = arguments[i] : throw std::invalid_argument("❌ Too many text arguments for rainbow().");
+		if (!arguments[i]->empty()) {
+			const Attributes attributes = resolveFormat(arguments[i]->data(), arguments[i]->size());
+			if (attributes != unknownFormat and !(attributes & ~styleMask))
+				styles |= attributes;
+			else
+				(!text) ? text = arguments[i] : throw std::invalid_argument("❌ Too many text arguments for rainbow().");
 		}
 		else
 			break;
 	}
 
-	if (string.empty())
-		return "🌈";
-	
-	std::string colors[6] = {"\033[31m", "\033[32m", "\033[33m", "\033[34m", "\033[35m", "\033[36m"};
-	std::string randomColors[8];
+	std::string result;
+	if (text)
+		appendRainbowText(result, text->data(), text->size(), styles);
+	else
+		appendRainbowText(result, "", 0, styles);
+	return result;
+}
+
+/**
+ * @brief Draws the order of the rainbow colors.
+ * 
+ * The six basic colors from red to cyan are shuffled with std::rand(), so that
+ * seeding it with std::srand() reproduces the same rainbow.
+ * 
+ * @param colors The SGR parameters of the colors (31 to 36), in their drawn order.
+ */
+void ColorFormat::shuffleRainbow(unsigned char colors[6]) {
+	unsigned char remaining[6] = {31, 32, 33, 34, 35, 36};
+
 	for (size_t i = 0 ; i < 6 ; i++) {
-		size_t randomIndex = std::rand() % (6 - i % 6);
-		randomColors[i] = colors[randomIndex];
-		colors[randomIndex] = colors[5 - i];
+		const size_t randomIndex = static_cast<size_t>(std::rand()) % (6 - i);
+		colors[i] = remaining[randomIndex];
+		remaining[randomIndex] = remaining[5 - i];
+	}
+}
+/**
+ * @brief Colors a text with a smooth truecolor gradient.
+ * 
+ * The colors are spread evenly over the characters of the text, from the first one to the last,
+ * and each character gets the color interpolated at its position. Styles can be given among
+ * the colors; they apply to the whole text.
+ * 
+ * @param text The text to color.
+ * @param firstFormat The first color.
+ * @param secondFormat The second color or a style.
+ * @param thirdFormat Optional color or style.
+ * @param fourthFormat Optional color or style.
+ * @param fifthFormat Optional color or style.
+ * @param sixthFormat Optional color or style.
+ * @return std::string The text with its gradient, or an empty string for an empty text.
+ * 
+ * @throws std::invalid_argument If fewer than two colors, a background color or an unknown format is given.
+ */
+const std::string ColorFormat::gradientText(const std::string &text,
+											const std::string &firstFormat,
+											const std::string &secondFormat,
+											const std::string &thirdFormat,
+											const std::string &fourthFormat,
+											const std::string &fifthFormat,
+											const std::string &sixthFormat) {
+	const std::string *parameters[6] = {&firstFormat, &secondFormat, &thirdFormat, &fourthFormat, &fifthFormat, &sixthFormat};
+	Attributes		  formats[6];
+	unsigned int	  stops[6];
+	size_t			  stopCount = 0;
+
+	for (size_t i = 0 ; i < 6 ; i++)
+		formats[i] = mergeFormat(0, *parameters[i]);
+
+	const Attributes styles = gradientStops(formats, 6, stops, stopCount);
+	std::string		 result;
+	appendGradientRuns(result, text.data(), text.size(), stops, stopCount, styles);
+	return result;
+}
+
+/**
+ * @brief Converts a foreground color to its 0xRRGGBB value.
+ * 
+ * The 16 basic colors and the 256-color palette are given the values of xterm.
+ * 
+ * @param color Attributes holding a foreground color.
+ * @return unsigned int The 0xRRGGBB value of the color, 0 if there is none.
+ */
+unsigned int ColorFormat::colorValue(const Attributes color) {
+	static const unsigned int basicColors[16] = {0x000000, 0xCD0000, 0x00CD00, 0xCDCD00, 0x0000EE, 0xCD00CD, 0x00CDCD, 0xE5E5E5,
+												 0x7F7F7F, 0xFF0000, 0x00FF00, 0xFFFF00, 0x5C5CFF, 0xFF00FF, 0x00FFFF, 0xFFFFFF};
+	static const unsigned int cubeLevels[6]	  = {0x00, 0x5F, 0x87, 0xAF, 0xD7, 0xFF};
+	const unsigned int		  kind			  = static_cast<unsigned int>(color >> foregroundKindShift & 3);
+	const unsigned int		  value			  = static_cast<unsigned int>(color >> foregroundShift & 0xFFFFFF);
+
+	if (kind == rgbColor)
+		return value;
+	if (kind == basicColor or value < 16)
+		return basicColors[value & 15];
+	if (value >= 232) {
+		const unsigned int gray = 8 + (value - 232) * 10;
+		return gray << 16 | gray << 8 | gray;
 	}
+	return cubeLevels[(value - 16) / 36] << 16 | cubeLevels[(value - 16) / 6 % 6] << 8 | cubeLevels[(value - 16) % 6];
+}
 
-	std::string rainbowString = "";
-	removePreviousFormats(string);
-	for (size_t i = 0 ; i < string.size() ; i++) {
-		if (string[i] == '\033' && i + 1 < string.size() && string[i + 1] == '[') {
-			while (i < string.size() && string[i] != 'm') {
-				rainbowString += string[i++];
-			}
-			rainbowString += 'm';
-			continue;
-		}
-		rainbowString += randomColors[i % 6] + string[i];
+/**
+ * @brief Sorts the formats given to gradientText() into its colors and styles.
+ * 
+ * @param formats The resolved formats, one per argument (0 for an empty one).
+ * @param count The number of formats.
+ * @param stops Receives the colors in their order, as 0xRRGGBB values.
+ * @param stopCount Receives the number of colors.
+ * @return Attributes The styles.
+ * 
+ * @throws std::invalid_argument If fewer than two colors, a background color or a duplicate style is given.
+ */
+ColorFormat::Attributes ColorFormat::gradientStops(const Attributes *formats, const size_t count, unsigned int *stops, size_t &stopCount) {
+	Attributes styles = 0;
+
+	stopCount = 0;
+	for (size_t i = 0 ; i < count ; i++) {
+		if (formats[i] & backgroundMask)
+			throw std::invalid_argument("❌ No background color is authorized with the gradient function.");
+		if (formats[i] & foregroundMask)
+			stops[stopCount++] = colorValue(formats[i]);
+		styles = mergeFormat(styles, formats[i] & styleMask);
 	}
+	if (stopCount < 2)
+		throw std::invalid_argument("❌ A gradient needs at least two colors.");
+	return styles;
+}
+
+/**
+ * @brief Interpolates the color of a character of gradientText().
+ * 
+ * The first character gets the first color and the last one the last color; the others
+ * are placed evenly in between, each channel being rounded to the nearest integer.
+ * 
+ * @param stops The colors, as 0xRRGGBB values.
+ * @param stopCount The number of colors, at least two.
+ * @param position The index of the character.
+ * @param positions The number of characters.
+ * @return unsigned int The 0xRRGGBB value of the character.
+ */
+unsigned int ColorFormat::gradientStopColor(const unsigned int *stops, const size_t stopCount, const size_t position, const size_t positions) {
+	if (positions < 2)
+		return stops[0];
 
-	return format + rainbowString + "\033[0m";
-}
\ No newline at end of file
+	const uint64_t span		= static_cast<uint64_t>(positions - 1);
+	const uint64_t progress = static_cast<uint64_t>(position) * (stopCount - 1);
+	const size_t   segment	= static_cast<size_t>(progress / span);
+	const uint64_t offset	= progress % span;
+
+	if (segment >= stopCount - 1)
+		return stops[stopCount - 1];
+
+	unsigned int color = 0;
+	for (unsigned int shift = 0 ; shift < 24 ; shift += 8) {
+		const uint64_t from = stops[segment]	 >> shift & 0xFF;
+		const uint64_t to	= stops[segment + 1] >> shift & 0xFF;
+		color |= static_cast<unsigned int>((from * (span - offset) + to * offset + span / 2) / span) << shift;
+	}
+	return color;
+}
@@ -12,7 +12,7 @@
  * 
  * @author aheitz
  * @date Created: 2025-02-17
- * @date Last Modified: 2025-02-18
+ * @date Last Modified: 2026-10-17
  */
 
 /* ############################################################################################## */
@@ -38,9 +38,34 @@
 
 /* ############################################################################################## */
 
+#include "InlineString.hpp"
+
+#include <cstddef>
 #include <cstdlib>
+#include <cstring>
 #include <iostream>
 #include <sstream>
+#include <stdexcept>
+#include <stdint.h>
+#include <string>
+#include <vector>
+#if __cplusplus >= 201703L
+# include <string_view>
+#endif
+
+/* ############################################################################################## */
+
+/**
+ * @brief Marks the functions that can be evaluated at compile time.
+ *
+ * The library itself only requires C++98, but since C++14 the format resolution can run
+ * inside constant expressions (e.g. when a std::format string is checked at compile time).
+ */
+#if __cplusplus >= 201402L
+# define COLORFORMAT_CONSTEXPR constexpr
+#else
+# define COLORFORMAT_CONSTEXPR inline
+#endif
 
 /* ############################################################################################## */
 
@@ -50,25 +75,352 @@
  * This class allows text formatting using ANSI codes, including colors, styles, and rainbow effects.
  */
 class ColorFormat {
+	public:
+		/**
+		 * @brief Packed set of formats, in a single 64-bit word.
+		 *
+		 * - bits 0-9: styles (see Format);
+		 * - bits 12-13 and 14-15: kind of the foreground and background colors (see ColorKind);
+		 * - bits 16-39 and 40-63: foreground and background colors, as a 16-color index,
+		 *   a 256-color index or a 0xRRGGBB value depending on their kind.
+		 */
+		typedef uint64_t Attributes;
+
+		/** How a color field is encoded. */
+		enum ColorKind { noColor = 0, basicColor = 1, paletteColor = 2, rgbColor = 3 };
+
+		enum {
+			styleCount			= 10,
+			foregroundKindShift	= 12,
+			backgroundKindShift	= 14,
+			foregroundShift		= 16,
+			backgroundShift		= 40,
+			prefixCapacity		= 80,	/**< Longest escape prefix written by writePrefix() */
+			transitionCapacity	= 84,	/**< Longest sequence written by writeTransition() */
+			deltaCapacity		= 96,	/**< Longest sequence written by writeDelta() */
+			thousandsCapacity	= 14	/**< Longest number written by writeThousands() */
+		};
+
+		static const Attributes styleMask	   = (static_cast<Attributes>(1) << styleCount) - 1;
+		static const Attributes foregroundMask = static_cast<Attributes>(3) << foregroundKindShift
+											   | static_cast<Attributes>(0xFFFFFF) << foregroundShift;
+		static const Attributes backgroundMask = static_cast<Attributes>(3) << backgroundKindShift
+											   | static_cast<Attributes>(0xFFFFFF) << backgroundShift;
+
+		/** Returned by resolveFormat() for a name that is neither a color nor a style. */
+		static const Attributes unknownFormat = ~static_cast<Attributes>(0);
+
+		/** Formats that can be passed without being named (e.g. `formatString(text, ColorFormat::bold)`). */
+		enum Format {
+			bold		= 1 << 0, underline	= 1 << 1, italic = 1 << 2, strikethrough	= 1 << 3, blink	   = 1 << 4,
+			dim			= 1 << 5, inverse	= 1 << 6, hidden = 1 << 7, doubleUnderline	= 1 << 8, overline = 1 << 9,
+			black		= basicColor << foregroundKindShift | 0  << foregroundShift,
+			red			= basicColor << foregroundKindShift | 1  << foregroundShift,
+			green		= basicColor << foregroundKindShift | 2  << foregroundShift,
+			yellow		= basicColor << foregroundKindShift | 3  << foregroundShift,
+			blue		= basicColor << foregroundKindShift | 4  << foregroundShift,
+			magenta		= basicColor << foregroundKindShift | 5  << foregroundShift,
+			cyan		= basicColor << foregroundKindShift | 6  << foregroundShift,
+			white		= basicColor << foregroundKindShift | 7  << foregroundShift,
+			brightBlack	= basicColor << foregroundKindShift | 8  << foregroundShift,
+			brightRed	= basicColor << foregroundKindShift | 9  << foregroundShift,
+			brightGreen	= basicColor << foregroundKindShift | 10 << foregroundShift,
+			brightYellow  = basicColor << foregroundKindShift | 11 << foregroundShift,
+			brightBlue	  = basicColor << foregroundKindShift | 12 << foregroundShift,
+			brightMagenta = basicColor << foregroundKindShift | 13 << foregroundShift,
+			brightCyan	  = basicColor << foregroundKindShift | 14 << foregroundShift,
+			brightWhite	  = basicColor << foregroundKindShift | 15 << foregroundShift
+		};
+
+		/** Returned by gradientColorIndex() when the number is outside of the range. */
+		enum { gradientTooLow = -1, gradientTooHigh = -2 };
 	private:
-		std::string _formattedString;
+		mutable std::string	_formattedString;
+		mutable const char	*_text;			/**< Lazy objects: text still to format, NULL once rendered */
+		size_t				_length;
+		Attributes			_attributes;
 
-		/** ANSI escape codes for colors */
-		static const std::string _colors[8][2];
+		/** Selects the constructor of lazy objects. */
+		struct Lazy {};
 
-		/** ANSI escape codes for styles */
-		static const std::string _styles[5][2];
+		ColorFormat(Lazy, const char *text, size_t length, Attributes attributes);
 
 		/**
-		 * @brief Removes all ANSI escape sequences from a string.
-		 * 
-		 * This function ensures that no previous formatting (e.g., colors, styles)
-		 * interferes with new formatting applied.
-		 * 
-		 * @param string The string to clean.
+		 * @brief Formats the text of a lazy object on first use, then returns the cached result.
+		 */
+		const std::string &rendered(void) const;
+
+		/** SGR parameters of the styles, in the order of their bits */
+		static const unsigned char _styleCodes[styleCount];
+
+		/** Fixed escape sequences, in each character type */
+		template <typename Char>
+		struct Escapes {
+			static const Char reset[4];
+		};
+
+		/**
+		 * @brief Compares a known format name with a (not null-terminated) candidate.
 		 */
-		static void removePreviousFormats(std::string &string);
+		static COLORFORMAT_CONSTEXPR bool sameName(const char *known, const char *name, size_t length);
+
+		/**
+		 * @brief Resolves a foreground color name: a basic name, `color(N)` or `#RRGGBB`.
+		 */
+		static COLORFORMAT_CONSTEXPR Attributes resolveColor(const char *name, size_t length);
+
+		/**
+		 * @brief Writes the escape sequence of one color field.
+		 * @param base 30 for the foreground, 40 for the background.
+		 */
+		static char *writeColor(char *buffer, unsigned int kind, unsigned int value, unsigned int base);
+
+		/** Writes the parameters of a color only, as in `38;5;208`. */
+		static char *writeColorParameters(char *buffer, unsigned int kind, unsigned int value, unsigned int base);
+
+		/**
+		 * @brief Adds one format to a set of attributes; empty names are ignored.
+		 * @throws std::invalid_argument on a second color, a duplicate style or an unknown name.
+		 */
+		static Attributes mergeFormat(Attributes attributes, const char *format, size_t length);
+		static Attributes mergeFormat(Attributes attributes, const std::string &format);
+		static Attributes mergeFormat(Attributes attributes, const char *format);
+		static Attributes mergeFormat(Attributes attributes, Attributes format);
+#if __cplusplus >= 201703L
+		static Attributes mergeFormat(Attributes attributes, std::string_view format);
+#endif
+
+#if __cplusplus >= 201103L
+		/**
+		 * @brief Formats a string of any character type, as formatString().
+		 */
+		template <typename Char, typename... Formats>
+		static std::basic_string<Char> formatCharacters(const std::basic_string<Char> &string, const Formats &...formats);
+#endif
+
+		/**
+		 * @brief Appends a number colored by its position in a range, as formatGradientUnsignedInteger().
+		 */
+		template <typename String>
+		static void appendGradient(String &output, unsigned int number, unsigned int minimum, unsigned int maximum, Attributes attributes);
+
+		/**
+		 * @brief Appends a text with a color per character, as rainbow().
+		 */
+		template <typename String>
+		static void appendRainbowText(String &output, const char *text, size_t length, Attributes styles);
+
+		/**
+		 * @brief Sorts the formats of gradientText() into colors and styles.
+		 * @param stops Receives the colors, as 0xRRGGBB values (at most `count`).
+		 * @return The styles.
+		 * @throws std::invalid_argument if fewer than two colors are given or a background is.
+		 */
+		static Attributes gradientStops(const Attributes *formats, size_t count, unsigned int *stops, size_t &stopCount);
+
+		/**
+		 * @brief Computes the color of a character of gradientText(), as a 0xRRGGBB value.
+		 */
+		static unsigned int gradientStopColor(const unsigned int *stops, size_t stopCount, size_t position, size_t positions);
+
+		/**
+		 * @brief Appends a text with a color per run of characters, as gradientText().
+		 */
+		template <typename String>
+		static void appendGradientRuns(String &output, const char *text, size_t length,
+									  const unsigned int *stops, size_t stopCount, Attributes styles);
 	public:
+		/**
+		 * @brief Draws the order of the six rainbow colors, as SGR parameters 31 to 36.
+		 *
+		 * The colors are drawn with std::rand(), so std::srand() makes the order reproducible.
+		 */
+		static void shuffleRainbow(unsigned char colors[6]);
+
+		/**
+		 * @brief Resolves a single format name (e.g. "red", "bold") to its attributes.
+		 *
+		 * Colors are `red`, `bright_red`, `color(208)` (256-color palette) or `#ff8800`,
+		 * and apply to the background with an `on_` prefix (e.g. `on_bright_blue`).
+		 * Usable in constant expressions since C++14.
+		 *
+		 * @param name The format name, not necessarily null-terminated.
+		 * @param length The length of the name.
+		 * @return The attributes of the format, or unknownFormat.
+		 */
+		static COLORFORMAT_CONSTEXPR Attributes resolveFormat(const char *name, size_t length);
+
+		/**
+		 * @brief Retrieves the name of a single style or 16-color foreground.
+		 * @return The name used by resolveFormat(), or an empty string if the format is not a single one.
+		 */
+		static COLORFORMAT_CONSTEXPR const char *formatName(Attributes format);
+
+		/** @name Attribute construction */
+		/** @{ */
+		/** Foreground color of the 256-color palette. */
+		static COLORFORMAT_CONSTEXPR Attributes palette(unsigned int index);
+		/** Truecolor foreground. */
+		static COLORFORMAT_CONSTEXPR Attributes rgb(unsigned int red, unsigned int green, unsigned int blue);
+		/** Moves the foreground color of a format to the background (e.g. `background(ColorFormat::red)`). */
+		static COLORFORMAT_CONSTEXPR Attributes background(Attributes foreground);
+		/** Moves the background color of a format to the foreground, the inverse of background(). */
+		static COLORFORMAT_CONSTEXPR Attributes foreground(Attributes background);
+		/** @} */
+
+		/**
+		 * @brief Converts the foreground color of a format to its 0xRRGGBB value.
+		 *
+		 * The 16 basic colors and the 256-color palette are given the values of xterm; move a
+		 * background color to the foreground first with foreground().
+		 */
+		static unsigned int colorValue(Attributes color);
+
+		/**
+		 * @brief Tells whether two sets of attributes cannot be merged.
+		 * @return true if both have a foreground, both have a background or they share a style.
+		 */
+		static COLORFORMAT_CONSTEXPR bool conflicting(Attributes first, Attributes second);
+
+		/**
+		 * @brief Applies attributes over others: the styles add up, the colors of `above` replace the ones `below`.
+		 */
+		static COLORFORMAT_CONSTEXPR Attributes overlay(Attributes below, Attributes above);
+
+		/**
+		 * @brief Writes the escape prefix of a set of attributes.
+		 *
+		 * The foreground comes first, then the background and the styles, each in its own sequence.
+		 *
+		 * @param attributes The attributes, as returned by resolveFormat() (possibly or'ed).
+		 * @param buffer The destination, of at least prefixCapacity bytes.
+		 * @return The number of bytes written (0 for no attributes).
+		 */
+		static size_t writePrefix(Attributes attributes, char *buffer);
+
+		/**
+		 * @brief Writes the escape prefix of a set of attributes in another character type (e.g. `wchar_t`).
+		 * @see writePrefix()
+		 */
+		template <typename Char>
+		static size_t writePrefix(Attributes attributes, Char *buffer);
+
+		/**
+		 * @brief Retrieves the escape prefix of a set of attributes.
+		 * @see writePrefix()
+		 */
+		static std::string prefix(Attributes attributes);
+
+		/**
+		 * @brief Writes the escape sequences that switch the terminal from some attributes to others.
+		 *
+		 * Only the added styles and changed colors are written, unless something is removed,
+		 * which requires a reset first.
+		 *
+		 * @param buffer The destination, of at least transitionCapacity bytes.
+		 * @return The number of bytes written (0 if both sets are equal).
+		 */
+		static size_t writeTransition(Attributes from, Attributes to, char *buffer);
+
+		/**
+		 * @brief Writes a single escape sequence that switches the terminal from some attributes to others.
+		 *
+		 * Unlike writeTransition(), removed styles and colors are turned off one by one (e.g. `22`
+		 * for bold, `39` for the foreground) instead of through a reset, so restoring an outer
+		 * style after an inner one only writes what differs. A reset is written when `to` is empty,
+		 * or followed by the parameters of `to` when that is shorter than turning attributes off.
+		 *
+		 * @param buffer The destination, of at least deltaCapacity bytes.
+		 * @return The number of bytes written (0 if both sets are equal).
+		 */
+		static size_t writeDelta(Attributes from, Attributes to, char *buffer);
+
+		/**
+		 * @brief Applies the parameters of an SGR sequence (`\033[...m`) to a terminal state.
+		 *
+		 * Styles, their reset codes, the 16, 256 and truecolor colors on both grounds and full
+		 * resets are understood; other parameters are ignored. An empty list stands for a reset.
+		 *
+		 * @param parameters The text between `\033[` and `m`, such as "1;38;5;208".
+		 * @param base The state restored by a reset, the default one unless spans are nested.
+		 * @return The state after the sequence.
+		 */
+		static Attributes applyParameters(Attributes state, const char *parameters, size_t length, Attributes base = 0);
+
+		/**
+		 * @brief Appends the escape prefix of a set of attributes to any string type.
+		 * @see writePrefix()
+		 */
+		template <typename String>
+		static void appendPrefix(String &output, Attributes attributes);
+
+		/**
+		 * @brief Appends a formatted text to any string type (std::string, std::pmr::string...).
+		 *
+		 * Writes the same bytes as formatString(): the prefix, the text stripped from its previous
+		 * formats when attributes are given, and a final reset. Nothing is written for an empty text.
+		 *
+		 * @param output The string to append to; only `append(const Char *, size_t)`, `size()`
+		 *               and `reserve()` are used, so its allocator is the only one involved.
+		 * @param text The text, of any character type (`char`, `wchar_t`, `char16_t`...); the
+		 *             escape sequences are written in the same type.
+		 */
+		template <typename String, typename Char>
+		static void appendFormatted(String &output, const Char *text, size_t length, Attributes attributes);
+
+		/**
+		 * @brief Writes an unsigned integer with a comma every three digits.
+		 * @param buffer The destination, of at least thousandsCapacity bytes.
+		 * @return The number of bytes written.
+		 */
+		static size_t writeThousands(unsigned int number, char *buffer);
+
+		/**
+		 * @brief Computes the 256-color index used by formatGradientUnsignedInteger().
+		 * @return An index of the 6x6x6 color cube, gradientTooLow or gradientTooHigh.
+		 */
+		static int gradientColorIndex(unsigned int number, unsigned int minimum, unsigned int maximum);
+
+#if __cplusplus >= 201103L
+		/**
+		 * @brief Folds any number of formats into a single set of attributes.
+		 * @param formats Format names (string literals, strings, string views) or ColorFormat::Format values.
+		 * @throws std::invalid_argument if multiple colors are used or an invalid style is detected.
+		 */
+		template <typename... Formats>
+		static Attributes mergeFormats(const Formats &...formats);
+#endif
+
+		/**
+		 * @name Output sizes
+		 *
+		 * Exact sizes of the outputs of the format functions, computed without rendering them,
+		 * so that a batch can reserve its buffer once:
+		 * ```
+		 * size_t size = 0;
+		 * for (size_t i = 0 ; i < count ; i++)
+		 *     size += ColorFormat::formattedUnsignedIntegerSize(values[i], ColorFormat::bold);
+		 * output.reserve(output.size() + size);
+		 * ```
+		 * The attributes are the resolved formats (see resolveFormat() and mergeFormats()).
+		 */
+		/** @{ */
+		/** Size of the output of writePrefix(). */
+		static size_t prefixSize(Attributes attributes);
+		/** Number of decimal digits of a number. */
+		static size_t digitCount(unsigned int number);
+		/** Size of the output of writeThousands(). */
+		static size_t thousandsSize(unsigned int number);
+		/** Size of the output of formatString() and appendFormatted(). */
+		static size_t formattedSize(const char *text, size_t length, Attributes attributes);
+		/** Size of the output of formatUnsignedInteger(). */
+		static size_t formattedUnsignedIntegerSize(unsigned int number, Attributes attributes = 0);
+		/** Size of the output of formatGradientUnsignedInteger(). */
+		static size_t formattedGradientSize(unsigned int number, unsigned int minimum, unsigned int maximum, Attributes attributes = 0);
+		/** Size of the output of rainbow(), whose colors do not change its size. */
+		static size_t formattedRainbowSize(const char *text, size_t length, Attributes styles = 0);
+		/** @} */
+
 		/**
 		 * @brief Constructs a formatted text with the given styles and colors.
 		 * @param string The text to format.
@@ -84,6 +436,47 @@ class ColorFormat {
 					const std::string &thirdFormat	= "",
 					const std::string &fourthFormat = "",
 					const std::string &fifthFormat	= "");
+#if __cplusplus >= 201103L
+		/**
+		 * @brief Constructs a formatted text with any number of formats.
+		 * @param string The text to format.
+		 * @param formats Format names (string literals, strings, string views) or ColorFormat::Format values.
+		 */
+		template <typename... Formats>
+		ColorFormat(const std::string &string, const Formats &...formats);
+#endif
+		/**
+		 * @name Lazy construction
+		 *
+		 * A lazy object only keeps a view of its text and its resolved formats; the text is
+		 * formatted the first time it is written to a stream or retrieved, then cached:
+		 * ```
+		 * const ColorFormat line = ColorFormat::lazy(message, "bold");
+		 * if (verbose)
+		 *     std::cout << line << std::endl;
+		 * ```
+		 * The text must outlive the object until it is rendered, so temporary strings are
+		 * rejected at compile time. Rendering is not synchronized: a lazy object must not be
+		 * rendered by several threads at once.
+		 */
+		/** @{ */
+#if __cplusplus >= 201703L
+		template <typename... Formats>
+		static ColorFormat lazy(std::string_view string, const Formats &...formats);
+		template <typename... Formats>
+		static ColorFormat lazy(const char *string, const Formats &...formats);
+		template <typename... Formats>
+		static ColorFormat lazy(std::string &&string, const Formats &...formats) = delete;
+#else
+		static ColorFormat lazy(const char *string, size_t length, Attributes attributes);
+		static ColorFormat lazy(const char *string, Attributes attributes = 0);
+		static ColorFormat lazy(const std::string &string, Attributes attributes = 0);
+# if __cplusplus >= 201103L
+		static ColorFormat lazy(std::string &&string, Attributes attributes = 0) = delete;
+# endif
+#endif
+		/** @} */
+
 		ColorFormat(const ColorFormat &source);
 		ColorFormat &operator=(const ColorFormat &source);
 		~ColorFormat(void);
@@ -94,6 +487,8 @@ class ColorFormat {
 		 */
 		const std::string getFormattedString(void) const;
 
+		friend std::ostream &operator<<(std::ostream &stream, const ColorFormat &format);
+
 		/**
 		 * @brief Formats a string with the given styles and colors.
 		 * @param string The text to format.
@@ -114,7 +509,57 @@ class ColorFormat {
 											  const std::string &fifthFormat  = "",
 											  const std::string &sixthFormat  = "");
 
-		
+#if __cplusplus >= 201103L
+		/**
+		 * @brief Formats a string with any number of styles and one color.
+		 *
+		 * The formats are resolved in place, without being copied, and folded into
+		 * a single set of attributes.
+		 *
+		 * @param string The text to format.
+		 * @param formats Format names (string literals, strings, string views) or ColorFormat::Format values.
+		 * @return The formatted string with applied styles and colors.
+		 * @throws std::invalid_argument if multiple colors are used or an invalid style is detected.
+		 */
+		template <typename... Formats>
+		static const std::string formatString(std::string string, const Formats &...formats);
+#endif
+
+		/**
+		 * @name Other character types
+		 *
+		 * Counterparts of formatString() for wide, UTF-16, UTF-32 and UTF-8 (`char8_t`) strings.
+		 * The escape sequences are written in the character type of the text, which is never
+		 * transcoded to or from a std::string:
+		 * ```
+		 * std::wcout << ColorFormat::formatString(L"Température", "red", "bold") << std::endl;
+		 * ```
+		 * The format names stay narrow strings.
+		 */
+		/** @{ */
+		static const std::wstring formatString(const std::wstring &string,
+											   const std::string &firstFormat  = "",
+											   const std::string &secondFormat = "",
+											   const std::string &thirdFormat  = "",
+											   const std::string &fourthFormat = "",
+											   const std::string &fifthFormat  = "",
+											   const std::string &sixthFormat  = "");
+#if __cplusplus >= 201103L
+		template <typename... Formats>
+		static const std::wstring formatString(const std::wstring &string, const Formats &...formats);
+
+		template <typename... Formats>
+		static const std::u16string formatString(const std::u16string &string, const Formats &...formats);
+
+		template <typename... Formats>
+		static const std::u32string formatString(const std::u32string &string, const Formats &...formats);
+#endif
+#ifdef __cpp_char8_t
+		template <typename... Formats>
+		static const std::u8string formatString(const std::u8string &string, const Formats &...formats);
+#endif
+		/** @} */
+
 	    /**
 		 * @brief Formats an unsigned integer with thousand separators.
 		 * 
@@ -142,6 +587,15 @@ class ColorFormat {
 													   const std::string &fifthFormat  = "",
 													   const std::string &sixthFormat  = "");
 
+#if __cplusplus >= 201103L
+		/**
+		 * @brief Formats an unsigned integer with thousand separators and any number of formats.
+		 * @see formatString()
+		 */
+		template <typename... Formats>
+		static const std::string formatUnsignedInteger(unsigned int number, const Formats &...formats);
+#endif
+
 		/**
 		 * @brief Applies a gradient color to an unsigned integer based on its value.
 		 * 
@@ -172,4 +626,537 @@ class ColorFormat {
 										 const std::string &thirdArgument  = "",
 										 const std::string &fourthArgument = "",
 										 const std::string &fifthArgument  = "");
-};
\ No newline at end of file
+
+		/**
+		 * @brief Colors a text with a smooth truecolor gradient, from left to right through the given colors.
+		 *
+		 * Each character (UTF-8 code point) gets the color interpolated at its position between the
+		 * colors, and consecutive characters of the same color share one escape sequence. Colors of
+		 * the palettes are converted to their usual RGB values, and styles can be mixed in:
+		 * ```
+		 * ColorFormat::gradientText("Build succeeded", "#ff5f00", "#ffd700", "#00d75f", "bold")
+		 * ```
+		 * @param text The text to color, stripped from its previous formats.
+		 * @param firstFormat The first color.
+		 * @param secondFormat The second color or a style.
+		 * @return The colored text, or an empty string for an empty text.
+		 * @throws std::invalid_argument if fewer than two colors, a background or an unknown format is given.
+		 */
+		static const std::string gradientText(const std::string &text,
+											  const std::string &firstFormat,
+											  const std::string &secondFormat,
+											  const std::string &thirdFormat  = "",
+											  const std::string &fourthFormat = "",
+											  const std::string &fifthFormat  = "",
+											  const std::string &sixthFormat  = "");
+
+#if __cplusplus >= 201103L
+		/**
+		 * @brief Colors a text with a gradient through any number of colors (e.g. `ColorFormat::rgb(255, 95, 0)`).
+		 * @see gradientText()
+		 */
+		template <typename... Formats>
+		static const std::string gradientText(const std::string &text, const Formats &...formats);
+#endif
+
+#if __cplusplus >= 201703L
+		/**
+		 * @name Allocator-aware output
+		 *
+		 * Counterparts of the functions above that append to a caller-provided string instead of
+		 * returning a std::string from the global allocator, e.g. to format a whole request
+		 * into a std::pmr::string backed by a std::pmr::monotonic_buffer_resource:
+		 * ```
+		 * std::pmr::monotonic_buffer_resource arena;
+		 * std::pmr::string line(&arena);
+		 * ColorFormat::appendString(line, "ERR", "red", "bold");
+		 * ColorFormat::appendGradientUnsignedInteger(line, latency, 100, 0);
+		 * ```
+		 * The output is byte for byte the one of the std::string functions; the formats are
+		 * resolved before anything is written.
+		 */
+		/** @{ */
+		template <typename String, typename... Formats>
+		static String &appendString(String &output, std::string_view string, const Formats &...formats);
+
+		template <typename String, typename... Formats>
+		static String &appendUnsignedInteger(String &output, unsigned int number, const Formats &...formats);
+
+		/** @throws std::invalid_argument if a foreground color is given. */
+		template <typename String, typename... Formats>
+		static String &appendGradientUnsignedInteger(String &output, unsigned int number,
+													 unsigned int minimum, unsigned int maximum, const Formats &...formats);
+
+		/** @throws std::invalid_argument if a format is not a style. */
+		template <typename String, typename... Formats>
+		static String &appendRainbow(String &output, std::string_view string, const Formats &...styles);
+
+		/** @throws std::invalid_argument if fewer than two colors or a background color are given. */
+		template <typename String, typename... Formats>
+		static String &appendGradientText(String &output, std::string_view string, const Formats &...formats);
+		/** @} */
+
+		/**
+		 * @name Inline output
+		 *
+		 * Counterparts of formatString(), formatUnsignedInteger() and formatGradientUnsignedInteger()
+		 * for short values, returned in place instead of on the heap (unless longer than `Capacity`):
+		 * ```
+		 * std::cout << ColorFormat::inlineUnsignedInteger(count, "bold") << std::endl;
+		 * ```
+		 */
+		/** @{ */
+		template <size_t Capacity = 48, typename... Formats>
+		static InlineString<Capacity> inlineString(std::string_view string, const Formats &...formats);
+
+		template <size_t Capacity = 48, typename... Formats>
+		static InlineString<Capacity> inlineUnsignedInteger(unsigned int number, const Formats &...formats);
+
+		template <size_t Capacity = 48, typename... Formats>
+		static InlineString<Capacity> inlineGradientUnsignedInteger(unsigned int number, unsigned int minimum, unsigned int maximum,
+																	const Formats &...formats);
+		/** @} */
+#endif
+};
+
+/* ############################################################################################## */
+
+COLORFORMAT_CONSTEXPR bool ColorFormat::sameName(const char *known, const char *name, const size_t length) {
+	size_t i = 0;
+
+	while (i < length and known[i] != '\0' and known[i] == name[i])
+		++i;
+	return i == length and known[i] == '\0';
+}
+
+COLORFORMAT_CONSTEXPR const char *ColorFormat::formatName(const Attributes format) {
+	const char *const colors[16] = {"black", "red", "green", "yellow", "blue", "magenta", "cyan", "white",
+									"bright_black", "bright_red", "bright_green", "bright_yellow",
+									"bright_blue", "bright_magenta", "bright_cyan", "bright_white"};
+	const char *const styles[styleCount] = {"bold", "underline", "italic", "strikethrough", "blink",
+											"dim", "inverse", "hidden", "double_underline", "overline"};
+
+	for (unsigned int i = 0 ; i < 16 ; i++)
+		if (format == (static_cast<Attributes>(basicColor) << foregroundKindShift | static_cast<Attributes>(i) << foregroundShift))
+			return colors[i];
+	for (unsigned int i = 0 ; i < styleCount ; i++)
+		if (format == static_cast<Attributes>(1) << i)
+			return styles[i];
+	return "";
+}
+
+COLORFORMAT_CONSTEXPR ColorFormat::Attributes ColorFormat::palette(const unsigned int index) {
+	return static_cast<Attributes>(paletteColor) << foregroundKindShift | static_cast<Attributes>(index & 0xFF) << foregroundShift;
+}
+
+COLORFORMAT_CONSTEXPR ColorFormat::Attributes ColorFormat::rgb(const unsigned int red, const unsigned int green, const unsigned int blue) {
+	return static_cast<Attributes>(rgbColor) << foregroundKindShift
+		 | static_cast<Attributes>((red & 0xFF) << 16 | (green & 0xFF) << 8 | (blue & 0xFF)) << foregroundShift;
+}
+
+COLORFORMAT_CONSTEXPR ColorFormat::Attributes ColorFormat::background(const Attributes foreground) {
+	return (foreground & ~foregroundMask)
+		 | (foreground >> foregroundKindShift & 3) << backgroundKindShift
+		 | (foreground >> foregroundShift & 0xFFFFFF) << backgroundShift;
+}
+
+COLORFORMAT_CONSTEXPR ColorFormat::Attributes ColorFormat::foreground(const Attributes background) {
+	return (background & ~backgroundMask)
+		 | (background >> backgroundKindShift & 3) << foregroundKindShift
+		 | (background >> backgroundShift & 0xFFFFFF) << foregroundShift;
+}
+
+COLORFORMAT_CONSTEXPR bool ColorFormat::conflicting(const Attributes first, const Attributes second) {
+	return (first & second & styleMask)
+		or ((first >> foregroundKindShift & 3) and (second >> foregroundKindShift & 3))
+		or ((first >> backgroundKindShift & 3) and (second >> backgroundKindShift & 3));
+}
+
+COLORFORMAT_CONSTEXPR ColorFormat::Attributes ColorFormat::overlay(Attributes below, const Attributes above) {
+	if (above >> foregroundKindShift & 3)
+		below &= ~foregroundMask;
+	if (above >> backgroundKindShift & 3)
+		below &= ~backgroundMask;
+	return below | above;
+}
+
+COLORFORMAT_CONSTEXPR ColorFormat::Attributes ColorFormat::resolveColor(const char *name, const size_t length) {
+	for (unsigned int i = 0 ; i < 16 ; i++)
+		if (sameName(formatName(static_cast<Attributes>(basicColor) << foregroundKindShift | static_cast<Attributes>(i) << foregroundShift), name, length))
+			return static_cast<Attributes>(basicColor) << foregroundKindShift | static_cast<Attributes>(i) << foregroundShift;
+
+	if (length > 7 and sameName("color(", name, 6) and name[length - 1] == ')') {
+		unsigned int index = 0;
+		for (size_t i = 6 ; i < length - 1 ; i++) {
+			if (name[i] < '0' or name[i] > '9' or (index = index * 10 + static_cast<unsigned int>(name[i] - '0')) > 255)
+				return unknownFormat;
+		}
+		return length - 7 <= 3 ? palette(index) : unknownFormat;
+	}
+
+	if (length == 7 and name[0] == '#') {
+		unsigned int value = 0;
+		for (size_t i = 1 ; i < 7 ; i++) {
+			const char digit = name[i];
+			if (digit >= '0' and digit <= '9')
+				value = value << 4 | static_cast<unsigned int>(digit - '0');
+			else if ((digit | 0x20) >= 'a' and (digit | 0x20) <= 'f')
+				value = value << 4 | static_cast<unsigned int>((digit | 0x20) - 'a' + 10);
+			else
+				return unknownFormat;
+		}
+		return rgb(value >> 16, value >> 8 & 0xFF, value & 0xFF);
+	}
+	return unknownFormat;
+}
+
+COLORFORMAT_CONSTEXPR ColorFormat::Attributes ColorFormat::resolveFormat(const char *name, const size_t length) {
+	if (length > 3 and sameName("on_", name, 3)) {
+		const Attributes color = resolveColor(name + 3, length - 3);
+		return color == unknownFormat ? unknownFormat : background(color);
+	}
+
+	const Attributes color = resolveColor(name, length);
+	if (color != unknownFormat)
+		return color;
+	for (unsigned int style = 0 ; style < styleCount ; style++)
+		if (sameName(formatName(static_cast<Attributes>(1) << style), name, length))
+			return static_cast<Attributes>(1) << style;
+	return unknownFormat;
+}
+
+/* ############################################################################################## */
+
+template <typename String>
+void ColorFormat::appendPrefix(String &output, const Attributes attributes) {
+	char buffer[prefixCapacity];
+
+	output.append(buffer, writePrefix(attributes, buffer));
+}
+
+template <typename Char>
+const Char ColorFormat::Escapes<Char>::reset[4] = {'\033', '[', '0', 'm'};
+
+template <typename Char>
+size_t ColorFormat::writePrefix(const Attributes attributes, Char *buffer) {
+	char		 prefix[prefixCapacity];
+	const size_t length = writePrefix(attributes, prefix);
+
+	for (size_t i = 0 ; i < length ; i++)
+		buffer[i] = static_cast<Char>(prefix[i]);
+	return length;
+}
+
+template <typename String, typename Char>
+void ColorFormat::appendFormatted(String &output, const Char *text, const size_t length, const Attributes attributes) {
+	Char   prefix[prefixCapacity];
+	size_t start = 0;
+
+	if (!length)
+		return;
+	const size_t prefixLength = writePrefix(attributes, prefix);
+	output.reserve(output.size() + prefixLength + length + 4);
+	output.append(prefix, prefixLength);
+
+	/* Previous formats are skipped up to the first unterminated escape sequence */
+	for (size_t i = 0 ; attributes and i + 1 < length ; ) {
+		if (text[i] == '\033' and text[i + 1] == '[') {
+			const Char *end = std::char_traits<Char>::find(text + i, length - i, static_cast<Char>('m'));
+			if (!end)
+				break;
+			output.append(text + start, i - start);
+			i = start = static_cast<size_t>(end - text) + 1;
+		} else
+			++i;
+	}
+	output.append(text + start, length - start);
+	output.append(Escapes<Char>::reset, 4);
+}
+
+template <typename String>
+void ColorFormat::appendGradient(String &output, const unsigned int number, const unsigned int minimum, const unsigned int maximum,
+								 const Attributes attributes) {
+	char		 digits[thousandsCapacity];
+	const size_t length		= writeThousands(number, digits);
+	const int	 colorIndex = gradientColorIndex(number, minimum, maximum);
+
+	if (colorIndex == gradientTooLow)
+		appendFormatted(output, digits, length, static_cast<Attributes>(red) | blink | bold);
+	else if (colorIndex == gradientTooHigh)
+		appendFormatted(output, digits, length, static_cast<Attributes>(green) | blink | bold);
+	else {
+		appendPrefix(output, palette(static_cast<unsigned int>(colorIndex)));
+		appendFormatted(output, digits, length, attributes);
+		output.append("\033[0m", 4);
+	}
+}
+
+template <typename String>
+void ColorFormat::appendRainbowText(String &output, const char *text, const size_t length, const Attributes styles) {
+	unsigned char colors[6];
+	char		  prefix[prefixCapacity];
+	size_t		  position = 0;	/* index of the character once the previous formats are removed */
+
+	if (!length) {
+		output.append("🌈", std::strlen("🌈"));
+		return;
+	}
+	shuffleRainbow(colors);
+	const size_t prefixLength = writePrefix(styles, prefix);
+	output.reserve(output.size() + prefixLength + length * 6 + 4);
+	output.append(prefix, prefixLength);
+
+	for (size_t i = 0 ; i < length ; i++) {
+		if (text[i] == '\033' and i + 1 < length and text[i + 1] == '[') {
+			const char *end = static_cast<const char *>(std::memchr(text + i, 'm', length - i));
+			if (end) {
+				i = static_cast<size_t>(end - text);
+				continue;
+			}
+			output.append(text + i, length - i);
+			output.append("m", 1);
+			break;
+		}
+		const char sequence[6] = {'\033', '[', '3', static_cast<char>('0' + colors[position++ % 6] - 30), 'm', text[i]};
+		output.append(sequence, 6);
+	}
+	output.append("\033[0m", 4);
+}
+
+template <typename String>
+void ColorFormat::appendGradientRuns(String &output, const char *text, const size_t length,
+									const unsigned int *stops, const size_t stopCount, const Attributes styles) {
+	std::vector<size_t> runs;		/* first character of each run of the same color */
+	std::vector<size_t> ends;		/* end of the escape sequence of each run in escapes */
+	std::string			escapes;
+	char				prefix[prefixCapacity];
+	size_t				characters = 0;
+	size_t				visible	   = 0;	/* bytes left once the previous formats are removed */
+	bool				stripping  = true;
+
+	if (!length)
+		return;
+
+	/* Previous formats are skipped up to the first unterminated escape sequence, as by formatString() */
+	for (size_t i = 0 ; i < length ; i++) {
+		if (stripping and text[i] == '\033' and i + 1 < length and text[i + 1] == '[') {
+			const char *end = static_cast<const char *>(std::memchr(text + i, 'm', length - i));
+			if (end) {
+				i = static_cast<size_t>(end - text);
+				continue;
+			}
+			stripping = false;
+		}
+		if ((static_cast<unsigned char>(text[i]) & 0xC0) != 0x80 or !visible)
+			++characters;
+		++visible;
+	}
+
+	unsigned int previous = ~0u;
+	for (size_t position = 0 ; position < characters ; position++) {
+		const unsigned int color = gradientStopColor(stops, stopCount, position, characters);
+		if (color != previous) {
+			runs.push_back(position);
+			escapes.append(prefix, writePrefix(rgb(color >> 16, color >> 8 & 0xFF, color & 0xFF), prefix));
+			ends.push_back(escapes.size());
+			previous = color;
+		}
+	}
+
+	const size_t stylesLength = writePrefix(styles, prefix);
+	output.reserve(output.size() + stylesLength + escapes.size() + visible + 4);
+	output.append(prefix, stylesLength);
+
+	size_t run		 = 0;
+	size_t character = 0;
+	size_t start	 = 0;
+	size_t written	 = 0;
+	stripping		 = true;
+	for (size_t i = 0 ; i < length ; i++) {
+		if (stripping and text[i] == '\033' and i + 1 < length and text[i + 1] == '[') {
+			const char *end = static_cast<const char *>(std::memchr(text + i, 'm', length - i));
+			if (end) {
+				output.append(text + start, i - start);
+				i	  = static_cast<size_t>(end - text);
+				start = i + 1;
+				continue;
+			}
+			stripping = false;
+		}
+		if ((static_cast<unsigned char>(text[i]) & 0xC0) != 0x80 or !written) {
+			if (run < runs.size() and runs[run] == character) {
+				const size_t escape = run ? ends[run - 1] : 0;
+				output.append(text + start, i - start);
+				output.append(escapes.data() + escape, ends[run] - escape);
+				start = i;
+				++run;
+			}
+			++character;
+		}
+		++written;
+	}
+	output.append(text + start, length - start);
+	output.append("\033[0m", 4);
+}
+
+/* ############################################################################################## */
+
+#if __cplusplus >= 201103L
+template <typename... Formats>
+ColorFormat::Attributes ColorFormat::mergeFormats(const Formats &...formats) {
+	Attributes attributes = 0;
+
+	const bool merged[] = {true, (attributes = mergeFormat(attributes, formats), true)...};
+	(void)merged;
+	return attributes;
+}
+
+template <typename... Formats>
+ColorFormat::ColorFormat(const std::string &string, const Formats &...formats)
+	: _formattedString(formatString(string, formats...)), _text(NULL), _length(0), _attributes(0) {}
+
+template <typename... Formats>
+const std::string ColorFormat::formatString(std::string string, const Formats &...formats) {
+	std::string result;
+
+	if (string.empty())
+		return result;
+	appendFormatted(result, string.data(), string.size(), mergeFormats(formats...));
+	return result;
+}
+
+template <typename Char, typename... Formats>
+std::basic_string<Char> ColorFormat::formatCharacters(const std::basic_string<Char> &string, const Formats &...formats) {
+	std::basic_string<Char> result;
+
+	if (string.empty())
+		return result;
+	appendFormatted(result, string.data(), string.size(), mergeFormats(formats...));
+	return result;
+}
+
+template <typename... Formats>
+const std::wstring ColorFormat::formatString(const std::wstring &string, const Formats &...formats) {
+	return formatCharacters(string, formats...);
+}
+
+template <typename... Formats>
+const std::u16string ColorFormat::formatString(const std::u16string &string, const Formats &...formats) {
+	return formatCharacters(string, formats...);
+}
+
+template <typename... Formats>
+const std::u32string ColorFormat::formatString(const std::u32string &string, const Formats &...formats) {
+	return formatCharacters(string, formats...);
+}
+
+#ifdef __cpp_char8_t
+template <typename... Formats>
+const std::u8string ColorFormat::formatString(const std::u8string &string, const Formats &...formats) {
+	return formatCharacters(string, formats...);
+}
+#endif
+
+template <typename... Formats>
+const std::string ColorFormat::formatUnsignedInteger(const unsigned int number, const Formats &...formats) {
+	char digits[thousandsCapacity];
+
+	return formatString(std::string(digits, writeThousands(number, digits)), formats...);
+}
+
+template <typename... Formats>
+const std::string ColorFormat::gradientText(const std::string &text, const Formats &...formats) {
+	const Attributes attributes[] = {0, mergeFormat(0, formats)...};
+	unsigned int	 stops[sizeof...(Formats) + 1];
+	size_t			 stopCount = 0;
+	const Attributes styles	   = gradientStops(attributes, sizeof...(Formats) + 1, stops, stopCount);
+	std::string		 result;
+
+	appendGradientRuns(result, text.data(), text.size(), stops, stopCount, styles);
+	return result;
+}
+#endif
+
+#if __cplusplus >= 201703L
+template <typename String, typename... Formats>
+String &ColorFormat::appendString(String &output, const std::string_view string, const Formats &...formats) {
+	appendFormatted(output, string.data(), string.size(), mergeFormats(formats...));
+	return output;
+}
+
+template <typename String, typename... Formats>
+String &ColorFormat::appendUnsignedInteger(String &output, const unsigned int number, const Formats &...formats) {
+	const Attributes attributes = mergeFormats(formats...);
+	char			 digits[thousandsCapacity];
+
+	appendFormatted(output, digits, writeThousands(number, digits), attributes);
+	return output;
+}
+
+template <typename String, typename... Formats>
+String &ColorFormat::appendGradientUnsignedInteger(String &output, const unsigned int number,
+												   const unsigned int minimum, const unsigned int maximum, const Formats &...formats) {
+	const Attributes attributes = mergeFormats(formats...);
+
+	if (attributes & foregroundMask)
+		throw std::invalid_argument("❌ No color is authorized with the gradiation function.");
+	appendGradient(output, number, minimum, maximum, attributes);
+	return output;
+}
+
+template <typename String, typename... Formats>
+String &ColorFormat::appendRainbow(String &output, const std::string_view string, const Formats &...styles) {
+	const Attributes attributes = mergeFormats(styles...);
+
+	if (attributes & ~styleMask)
+		throw std::invalid_argument("❌ No color is authorized with the rainbow function.");
+	appendRainbowText(output, string.data(), string.size(), attributes);
+	return output;
+}
+
+template <typename String, typename... Formats>
+String &ColorFormat::appendGradientText(String &output, const std::string_view string, const Formats &...formats) {
+	const Attributes attributes[] = {0, mergeFormat(0, formats)...};
+	unsigned int	 stops[sizeof...(Formats) + 1];
+	size_t			 stopCount = 0;
+	const Attributes styles	   = gradientStops(attributes, sizeof...(Formats) + 1, stops, stopCount);
+
+	appendGradientRuns(output, string.data(), string.size(), stops, stopCount, styles);
+	return output;
+}
+
+template <typename... Formats>
+ColorFormat ColorFormat::lazy(const std::string_view string, const Formats &...formats) {
+	return ColorFormat(Lazy(), string.data(), string.size(), mergeFormats(formats...));
+}
+
+template <typename... Formats>
+ColorFormat ColorFormat::lazy(const char *string, const Formats &...formats) {
+	return lazy(std::string_view(string), formats...);
+}
+
+template <size_t Capacity, typename... Formats>
+InlineString<Capacity> ColorFormat::inlineString(const std::string_view string, const Formats &...formats) {
+	InlineString<Capacity> output;
+
+	appendString(output, string, formats...);
+	return output;
+}
+
+template <size_t Capacity, typename... Formats>
+InlineString<Capacity> ColorFormat::inlineUnsignedInteger(const unsigned int number, const Formats &...formats) {
+	InlineString<Capacity> output;
+
+	appendUnsignedInteger(output, number, formats...);
+	return output;
+}
+
+template <size_t Capacity, typename... Formats>
+InlineString<Capacity> ColorFormat::inlineGradientUnsignedInteger(const unsigned int number, const unsigned int minimum, const unsigned int maximum,
+																  const Formats &...formats) {
+	InlineString<Capacity> output;
+
+	appendGradientUnsignedInteger(output, number, minimum, maximum, formats...);
+	return output;
+}
+#endif
@@ -0,0 +1,241 @@
+#pragma once
+
+/* ############################################################################################## */
+
+/**
+ * @file ColorFormatter.hpp
+ * @brief std::format integration of the ColorFormat styles.
+ *
+ * Wrapping a value in a ColorField lets std::format apply colors and styles straight
+ * into its output, without building an intermediate ColorFormat string:
+ * ```
+ * std::format("{:red,bold}", ColorField(value));
+ * std::format("{:grad(0,100)}", ColorField(percent));
+ * std::format("{:underline:>8}", ColorField(count));   // the part after ':' formats the value
+ * ```
+ * The style specification is resolved when the format string is parsed, which the
+ * standard library does at compile time: an unknown style is a compilation error.
+ *
+ * Requires C++20 and a standard library providing <format>.
+ *
+ * @author aheitz
+ * @date Created: 2026-10-17
+ * @date Last Modified: 2026-10-17
+ */
+
+/* ############################################################################################## */
+
+/*
+ * This file is part of the ColorFormat library.
+ *
+ * Copyright (C) 2025 aheitz <alexy.pa.heitz@gmail.com>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+/* ############################################################################################## */
+
+#include "ColorFormat.hpp"
+
+#include <format>
+#include <limits>
+#include <memory>
+#include <string_view>
+#include <type_traits>
+
+/* ############################################################################################## */
+
+/**
+ * @brief Marks a value to be formatted with a ColorFormat style specification.
+ *
+ * The wrapper only holds a reference: it is meant to live inside the std::format call.
+ */
+template <typename T>
+struct ColorField {
+	const T &value;
+
+	explicit ColorField(const T &value) : value(value) {}
+};
+
+/* ############################################################################################## */
+
+/**
+ * @brief Style specification of a ColorField, as parsed from a format string.
+ *
+ * Grammar: `style[,style...][:value-spec]`, where a style is a color, a text style
+ * or `grad(minimum,maximum)`. The gradient excludes any other color, as in
+ * ColorFormat::formatGradientUnsignedInteger().
+ */
+struct ColorFieldSpec {
+	ColorFormat::Attributes attributes = 0;
+	bool					gradient   = false;
+	unsigned int			minimum	   = 0;
+	unsigned int			maximum	   = 0;
+
+	/** Room for the longest style name, `on_bright_magenta`; `grad(...)` is read in place. */
+	static constexpr size_t nameCapacity = 24;
+
+	/**
+	 * @brief Parses the styles of a replacement field.
+	 * @param begin The first character of the specification.
+	 * @param end The end of the format string.
+	 * @return The position of the closing '}' or of the ':' introducing the value specification.
+	 * @throws std::format_error if a style is unknown, too long, duplicated or conflicting.
+	 */
+	template <typename CharT>
+	constexpr const CharT *parse(const CharT *begin, const CharT *end) {
+		const CharT *position = begin;
+
+		while (position != end and *position != '}' and *position != ':') {
+			const CharT *start	 = position;
+			bool		argument = false;
+
+			while (position != end and (argument or (*position != ',' and *position != '}' and *position != ':'))) {
+				if (*position == '(' or *position == ')')
+					argument = *position == '(';
+				++position;
+			}
+
+			const size_t length = static_cast<size_t>(position - start);
+
+			if (length > 5 and start[0] == 'g' and start[1] == 'r' and start[2] == 'a' and start[3] == 'd' and start[4] == '(') {
+				if (gradient or attributes & ColorFormat::foregroundMask)
+					throw std::format_error("Invalid ColorFormat gradient.");
+				parseNumber(parseNumber(start + 5, position, minimum, ','), position, maximum, ')');
+				gradient = true;
+			} else {
+				char name[nameCapacity] = {};
+
+				if (length > nameCapacity)
+					throw std::format_error("ColorFormat style name too long.");
+				for (size_t i = 0 ; i < length ; i++)
+					name[i] = static_cast<char>(start[i]);
+
+				const ColorFormat::Attributes added = ColorFormat::resolveFormat(name, length);
+				if (added == ColorFormat::unknownFormat)
+					throw std::format_error("Unknown ColorFormat style.");
+				if (ColorFormat::conflicting(attributes, added) or (gradient and added & ColorFormat::foregroundMask))
+					throw std::format_error("Conflicting ColorFormat styles.");
+				attributes |= added;
+			}
+
+			if (position != end and *position == ',')
+				++position;
+		}
+		return position;
+	}
+
+	/**
+	 * @brief Reads a decimal bound of `grad(minimum,maximum)` and skips its terminator.
+	 */
+	template <typename CharT>
+	static constexpr const CharT *parseNumber(const CharT *position, const CharT *end, unsigned int &number, char terminator) {
+		unsigned long long value = 0;
+
+		if (position == end or *position < '0' or *position > '9')
+			throw std::format_error("Invalid ColorFormat gradient.");
+		while (position != end and *position >= '0' and *position <= '9') {
+			value = value * 10 + static_cast<unsigned long long>(*position++ - '0');
+			if (value > std::numeric_limits<unsigned int>::max())
+				throw std::format_error("ColorFormat gradient bound out of range.");
+		}
+		if (position == end or *position != terminator or (terminator == ')' and position + 1 != end))
+			throw std::format_error("Invalid ColorFormat gradient.");
+		number = static_cast<unsigned int>(value);
+		return position + 1;
+	}
+};
+
+/* ############################################################################################## */
+
+namespace std {
+	/**
+	 * @brief std::format support for ColorField.
+	 *
+	 * The escape sequences are written directly into the output iterator, around
+	 * the value formatted by the regular std::formatter<T>.
+	 */
+	template <typename T, typename CharT>
+	struct formatter<ColorField<T>, CharT> {
+		ColorFieldSpec			_spec;
+		formatter<T, CharT>		_value;
+
+		/** Out-of-range numbers blink in bold red (too low) or green (too high), as in ColorFormat. */
+		static constexpr ColorFormat::Attributes _tooLow  = ColorFormat::red   | ColorFormat::blink | ColorFormat::bold;
+		static constexpr ColorFormat::Attributes _tooHigh = ColorFormat::green | ColorFormat::blink | ColorFormat::bold;
+
+		/** Integers that the gradient can locate. */
+		static constexpr bool _gradable = is_integral_v<T> and !is_same_v<T, bool>;
+
+		constexpr typename basic_format_parse_context<CharT>::iterator parse(basic_format_parse_context<CharT> &context) {
+			const CharT *begin	  = std::to_address(context.begin());
+			const CharT *position = _spec.parse(begin, std::to_address(context.end()));
+
+			if (_spec.gradient and !_gradable)
+				throw format_error("The ColorFormat gradient only applies to integers.");
+			if (position != std::to_address(context.end()) and *position == ':')
+				++position;
+			context.advance_to(context.begin() + (position - begin));
+			return _value.parse(context);
+		}
+
+		template <typename Context>
+		typename Context::iterator format(const ColorField<T> &field, Context &context) const {
+			typename Context::iterator output	  = context.out();
+			ColorFormat::Attributes	   attributes = _spec.attributes;
+
+			if (_spec.gradient) {
+				const int colorIndex = gradientColorIndex(field.value);
+
+				if (colorIndex == ColorFormat::gradientTooLow)
+					attributes |= _tooLow;
+				else if (colorIndex == ColorFormat::gradientTooHigh)
+					attributes |= _tooHigh;
+				else
+					attributes |= ColorFormat::palette(static_cast<unsigned int>(colorIndex));
+			}
+			if (!attributes)
+				return _value.format(field.value, context);
+
+			char prefix[ColorFormat::prefixCapacity];
+			output = write(output, string_view(prefix, ColorFormat::writePrefix(attributes, prefix)));
+			context.advance_to(output);
+			output = _value.format(field.value, context);
+			return write(output, string_view("\033[0m", 4));
+		}
+
+		private:
+			/**
+			 * @brief Locates any integer in the gradient, including the ones an unsigned int cannot hold.
+			 */
+			int gradientColorIndex(const T &value) const {
+				if constexpr (_gradable) {
+					if constexpr (is_signed_v<T>)
+						if (value < 0)
+							return _spec.minimum <= _spec.maximum ? ColorFormat::gradientTooLow : ColorFormat::gradientTooHigh;
+					if (static_cast<make_unsigned_t<T>>(value) > numeric_limits<unsigned int>::max())
+						return _spec.minimum < _spec.maximum ? ColorFormat::gradientTooHigh : ColorFormat::gradientTooLow;
+					return ColorFormat::gradientColorIndex(static_cast<unsigned int>(value), _spec.minimum, _spec.maximum);
+				} else
+					return ColorFormat::gradientTooLow;
+			}
+
+			template <typename Iterator>
+			static Iterator write(Iterator output, string_view escape) {
+				for (size_t i = 0 ; i < escape.size() ; i++)
+					*output++ = static_cast<CharT>(escape[i]);
+				return output;
+			}
+	};
+}
@@ -0,0 +1,203 @@
+#include "ColorMarkup.hpp"
+
+/* ############################################################################################## */
+
+/**
+ * @file ColorMarkup.cpp
+ * @brief Implementation of the ColorMarkup class.
+ *
+ * This file contains the compilation of runtime templates and the rendering of
+ * compiled operations and their arguments.
+ *
+ * @author aheitz
+ * @date Created: 2026-10-17
+ * @date Last Modified: 2026-10-17
+ */
+
+/* ############################################################################################## */
+
+/*
+ * This file is part of the ColorFormat library.
+ *
+ * Copyright (C) 2025 aheitz <alexy.pa.heitz@gmail.com>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+/* ############################################################################################## */
+
+#include <cstdio>
+#include <cstring>
+#include <memory>
+#include <unordered_map>
+
+/* ############################################################################################## */
+
+namespace {
+	/** Text of a cached template, pointing into the ColorMarkup that holds its copy. */
+	struct MarkupKey {
+		const char	*text;
+		size_t		length;
+
+		bool operator==(const MarkupKey &other) const { return length == other.length and !std::memcmp(text, other.text, length); }
+	};
+
+	/** FNV-1a over the text of a template. */
+	struct MarkupHash {
+		size_t operator()(const MarkupKey &key) const {
+			size_t hash = static_cast<size_t>(14695981039346656037ull);
+
+			for (size_t i = 0 ; i < key.length ; i++)
+				hash = (hash ^ static_cast<unsigned char>(key.text[i])) * static_cast<size_t>(1099511628211ull);
+			return hash;
+		}
+	};
+}
+
+/* ############################################################################################## */
+
+/**
+ * @brief Compiles a markup template.
+ *
+ * The template is parsed once: rendering only walks the resulting operations.
+ *
+ * @param markup The template to compile.
+ * @throws std::invalid_argument If the template is malformed.
+ */
+ColorMarkup::ColorMarkup(const std::string &markup) : _markup(markup), _operations(), _slotCount(0) {
+	OperationList operations = {_operations};
+	_slotCount = compile(_markup.data(), _markup.size(), operations);
+}
+
+/**
+ * @brief Retrieves the compiled template of a markup, compiling it on the first use.
+ *
+ * The lookup hashes the text in place, so a cached template is found without allocating.
+ * Each entry keeps its own copy of the text, which the key points into.
+ *
+ * @param markup The template.
+ * @return The compiled template, valid until the thread ends.
+ * @throws std::invalid_argument If the template is malformed.
+ */
+const ColorMarkup &ColorMarkup::compiled(const char *markup) {
+	typedef std::unordered_map<MarkupKey, std::unique_ptr<ColorMarkup>, MarkupHash> Cache;
+
+	static thread_local Cache cache;
+	const MarkupKey			  key	= {markup, std::strlen(markup)};
+	Cache::iterator			  entry = cache.find(key);
+
+	if (entry == cache.end()) {
+		std::unique_ptr<ColorMarkup> compiled(new ColorMarkup(std::string(markup, key.length)));
+		const MarkupKey				 ownKey = {compiled->_markup.data(), compiled->_markup.size()};
+
+		entry = cache.emplace(ownKey, std::move(compiled)).first;
+	}
+	return *entry->second;
+}
+
+/* ############################################################################################## */
+
+/**
+ * @brief Executes compiled operations.
+ *
+ * Literal spans are copied from the template, escapes are written by
+ * ColorFormat::writePrefix() and arguments are appended in the order of their slots.
+ *
+ * @param markup The template the operations refer to.
+ * @param operations The compiled operations.
+ * @param operationCount The number of operations.
+ * @param slotCount The number of argument slots of the template.
+ * @param arguments The arguments to render.
+ * @param argumentCount The number of arguments.
+ * @param output The buffer to append to.
+ *
+ * @throws std::invalid_argument If the number of arguments does not match the slots.
+ */
+void ColorMarkup::render(const char *markup, const Operation *operations, const size_t operationCount, const size_t slotCount,
+						 const Argument *arguments, const size_t argumentCount, std::string &output) {
+	size_t length	= 0;
+	size_t argument = 0;
+
+	if (argumentCount != slotCount)
+		throw std::invalid_argument("❌ The number of arguments does not match the markup template.");
+
+	for (size_t i = 0 ; i < operationCount ; i++)
+		length += operations[i].kind == Operation::literal ? operations[i].length : 16;
+	output.reserve(output.size() + length);
+
+	for (size_t i = 0 ; i < operationCount ; i++) {
+		const Operation &operation = operations[i];
+
+		if (operation.kind == Operation::literal)
+			output.append(markup + operation.offset, operation.length);
+		else if (operation.kind == Operation::argument) {
+			arguments[argument].append(output, arguments[argument].value);
+			++argument;
+		} else {
+			char prefix[ColorFormat::prefixCapacity];
+
+			if (operation.length)
+				output += "\033[0m";
+			output.append(prefix, ColorFormat::writePrefix(operation.attributes, prefix));
+		}
+	}
+}
+
+/* ############################################################################################## */
+
+void ColorMarkup::append(std::string &output, const std::string &value) { output += value; }
+
+void ColorMarkup::append(std::string &output, const char *value) { output += value; }
+
+void ColorMarkup::append(std::string &output, const char value) { output += value; }
+
+void ColorMarkup::append(std::string &output, const bool value) { output += value ? "true" : "false"; }
+
+void ColorMarkup::append(std::string &output, const ColorFormat &value) { output += value.getFormattedString(); }
+
+/**
+ * @brief Appends a signed integer without going through a stream.
+ */
+void ColorMarkup::append(std::string &output, const long long value) {
+	if (value < 0) {
+		output += '-';
+		append(output, 0ull - static_cast<unsigned long long>(value));
+	} else
+		append(output, static_cast<unsigned long long>(value));
+}
+
+/**
+ * @brief Appends an unsigned integer without going through a stream.
+ */
+void ColorMarkup::append(std::string &output, unsigned long long value) {
+	char  digits[20];
+	char *position = digits + sizeof(digits);
+
+	do {
+		*--position = static_cast<char>('0' + value % 10);
+		value /= 10;
+	} while (value);
+	output.append(position, digits + sizeof(digits) - position);
+}
+
+/**
+ * @brief Appends a floating-point number with the shortest of the fixed and scientific notations.
+ */
+void ColorMarkup::append(std::string &output, const double value) {
+	char digits[32];
+	const int length = std::snprintf(digits, sizeof(digits), "%g", value);
+
+	if (length > 0)
+		output.append(digits, static_cast<size_t>(length));
+}
@@ -0,0 +1,326 @@
+#pragma once
+
+/* ############################################################################################## */
+
+/**
+ * @file ColorMarkup.hpp
+ * @brief Declaration of the ColorMarkup class for inline markup templates.
+ *
+ * A markup template describes a whole line with its styled spans and argument slots:
+ * ```
+ * ColorMarkup::format("[red]ERR[/] [bold]{}[/] took {}", name, duration);
+ * ```
+ * The template is compiled once into a list of operations (literal spans, escape prefixes
+ * and argument slots), then every rendering appends into a single buffer.
+ *
+ * Requires C++11; templates compiled at compile time (StaticColorMarkup) require C++14.
+ *
+ * @author aheitz
+ * @date Created: 2026-10-17
+ * @date Last Modified: 2026-10-17
+ */
+
+/* ############################################################################################## */
+
+/*
+ * This file is part of the ColorFormat library.
+ *
+ * Copyright (C) 2025 aheitz <alexy.pa.heitz@gmail.com>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+/* ############################################################################################## */
+
+#include "ColorFormat.hpp"
+
+#include <string>
+#include <vector>
+
+/* ############################################################################################## */
+
+/**
+ * @brief Compiled markup template.
+ *
+ * Syntax:
+ * - `[red bold]` opens a span with the given formats, `[/]` closes the last opened span;
+ * - `{}` is replaced by the next argument;
+ * - `[[`, `]]`, `{{` and `}}` stand for the literal characters; a lone `]` is kept as is.
+ *
+ * Closing a span resets the terminal and restores the formats of the enclosing spans.
+ */
+class ColorMarkup {
+	public:
+		/** One step of a compiled template. */
+		struct Operation {
+			enum Kind { literal, escape, argument };
+
+			Kind					kind;
+			size_t					offset;		/**< literal: position in the template */
+			size_t					length;		/**< literal: length; escape: non-zero to reset first */
+			ColorFormat::Attributes	attributes;	/**< escape: formats to apply */
+		};
+
+		/** Deepest nesting of spans in a template. */
+		enum { maximumDepth = 16 };
+
+		/**
+		 * @brief Type-erased reference to a rendering argument.
+		 */
+		struct Argument {
+			const void *value;
+			void		(*append)(std::string &output, const void *value);
+		};
+
+		/**
+		 * @brief Compiles a markup template.
+		 * @param markup The template, copied into the object.
+		 * @throws std::invalid_argument if the template is malformed.
+		 */
+		explicit ColorMarkup(const std::string &markup);
+
+		/**
+		 * @brief Renders the template and appends the result to a buffer.
+		 * @throws std::invalid_argument if the number of arguments does not match the slots.
+		 */
+		template <typename... Arguments>
+		void render(std::string &output, const Arguments &...arguments) const;
+
+		/**
+		 * @brief Renders the template into a new string.
+		 */
+		template <typename... Arguments>
+		std::string operator()(const Arguments &...arguments) const;
+
+		/**
+		 * @brief Renders a template, compiled on the first use and cached by its text.
+		 *
+		 * The cache is per thread and shared by all the argument types, so a template is
+		 * compiled once per thread however it is called.
+		 */
+		template <typename... Arguments>
+		static std::string format(const char *markup, const Arguments &...arguments);
+
+		/**
+		 * @brief Parses a template, calling `operations.push(operation)` for each step.
+		 *
+		 * Usable in constant expressions since C++14 (see StaticColorMarkup).
+		 *
+		 * @return The number of argument slots.
+		 * @throws std::invalid_argument if the template is malformed.
+		 */
+		template <typename Operations>
+		static COLORFORMAT_CONSTEXPR size_t compile(const char *markup, size_t length, Operations &operations);
+
+		/**
+		 * @brief Executes compiled operations, appending to the output.
+		 * @throws std::invalid_argument if the number of arguments does not match the slots.
+		 */
+		static void render(const char *markup, const Operation *operations, size_t operationCount, size_t slotCount,
+						   const Argument *arguments, size_t argumentCount, std::string &output);
+
+		/** @name Argument rendering */
+		/** @{ */
+		static void append(std::string &output, const std::string &value);
+		static void append(std::string &output, const char *value);
+		static void append(std::string &output, char value);
+		static void append(std::string &output, bool value);
+		static void append(std::string &output, long long value);
+		static void append(std::string &output, unsigned long long value);
+		static void append(std::string &output, int value)			  { append(output, static_cast<long long>(value)); }
+		static void append(std::string &output, long value)			  { append(output, static_cast<long long>(value)); }
+		static void append(std::string &output, unsigned int value)	  { append(output, static_cast<unsigned long long>(value)); }
+		static void append(std::string &output, unsigned long value)  { append(output, static_cast<unsigned long long>(value)); }
+		static void append(std::string &output, double value);
+		static void append(std::string &output, const ColorFormat &value);
+		template <typename T>
+		static void append(std::string &output, const T &value);
+		/** @} */
+	private:
+		std::string				_markup;
+		std::vector<Operation>	_operations;
+		size_t					_slotCount;
+
+		/** Collects the operations of a runtime template. */
+		struct OperationList {
+			std::vector<Operation> &operations;
+
+			void push(const Operation &operation) { operations.push_back(operation); }
+		};
+
+		template <typename T>
+		static void appendErased(std::string &output, const void *value) { append(output, *static_cast<const T *>(value)); }
+
+		template <typename T>
+		static Argument erase(const T &value) { Argument argument = {&value, &appendErased<T>}; return argument; }
+
+		/** Retrieves the compiled template of format(), compiling it on the first use. */
+		static const ColorMarkup &compiled(const char *markup);
+};
+
+/* ############################################################################################## */
+
+/**
+ * @brief Markup template compiled at compile time.
+ *
+ * ```
+ * static constexpr StaticColorMarkup<8> line("[red]ERR[/] {}");
+ * std::string text = line("disk full");
+ * ```
+ * The template must outlive the object, which is the case of string literals.
+ *
+ * @tparam Capacity The maximum number of operations of the template.
+ */
+template <size_t Capacity>
+class StaticColorMarkup {
+	public:
+		COLORFORMAT_CONSTEXPR explicit StaticColorMarkup(const char *markup)
+			: _markup(markup), _operations{}, _operationCount(0), _slotCount(0) {
+			size_t length = 0;
+
+			while (markup[length])
+				++length;
+			_slotCount = ColorMarkup::compile(markup, length, *this);
+		}
+
+		COLORFORMAT_CONSTEXPR void push(const ColorMarkup::Operation &operation) {
+			if (_operationCount == Capacity)
+				throw std::invalid_argument("❌ Too many operations for the StaticColorMarkup capacity.");
+			_operations[_operationCount++] = operation;
+		}
+
+		template <typename... Arguments>
+		void render(std::string &output, const Arguments &...arguments) const {
+			const ColorMarkup::Argument erased[] = {{0, 0}, ColorMarkup::Argument{&arguments, &appendErased<Arguments>}...};
+			ColorMarkup::render(_markup, _operations, _operationCount, _slotCount, erased + 1, sizeof...(Arguments), output);
+		}
+
+		template <typename... Arguments>
+		std::string operator()(const Arguments &...arguments) const {
+			std::string output;
+			render(output, arguments...);
+			return output;
+		}
+	private:
+		const char				*_markup;
+		ColorMarkup::Operation	_operations[Capacity];
+		size_t					_operationCount;
+		size_t					_slotCount;
+
+		template <typename T>
+		static void appendErased(std::string &output, const void *value) { ColorMarkup::append(output, *static_cast<const T *>(value)); }
+};
+
+/* ############################################################################################## */
+
+template <typename T>
+void ColorMarkup::append(std::string &output, const T &value) {
+	std::ostringstream stream;
+	stream << value;
+	output += stream.str();
+}
+
+template <typename... Arguments>
+void ColorMarkup::render(std::string &output, const Arguments &...arguments) const {
+	const Argument erased[] = {{0, 0}, erase(arguments)...};
+	render(_markup.data(), _operations.data(), _operations.size(), _slotCount, erased + 1, sizeof...(Arguments), output);
+}
+
+template <typename... Arguments>
+std::string ColorMarkup::operator()(const Arguments &...arguments) const {
+	std::string output;
+	render(output, arguments...);
+	return output;
+}
+
+template <typename... Arguments>
+std::string ColorMarkup::format(const char *markup, const Arguments &...arguments) {
+	return compiled(markup)(arguments...);
+}
+
+template <typename Operations>
+COLORFORMAT_CONSTEXPR size_t ColorMarkup::compile(const char *markup, const size_t length, Operations &operations) {
+	ColorFormat::Attributes spans[maximumDepth] = {};
+	size_t					depth				= 0;
+	size_t					slots				= 0;
+	size_t					start				= 0;
+	size_t					i					= 0;
+
+	while (i < length) {
+		const char current = markup[i];
+		const char next	   = i + 1 < length ? markup[i + 1] : '\0';
+
+		const bool doubled = (current == '[' or current == ']' or current == '{' or current == '}') and next == current;
+
+		if ((doubled or current == '[' or current == '{' or current == '}') and i > start)
+			operations.push(Operation{Operation::literal, start, i - start, 0});
+
+		if (doubled) {
+			operations.push(Operation{Operation::literal, i, 1, 0});
+			start = i += 2;
+		} else if (current == '{') {
+			if (next != '}')
+				throw std::invalid_argument("❌ Unmatched '{' in markup template.");
+			operations.push(Operation{Operation::argument, i, 0, 0});
+			++slots;
+			start = i += 2;
+		} else if (current == '}') {
+			throw std::invalid_argument("❌ Unmatched '}' in markup template.");
+		} else if (current == '[' and next == '/') {
+			if (i + 2 >= length or markup[i + 2] != ']')
+				throw std::invalid_argument("❌ Malformed closing tag in markup template.");
+			if (depth == 0)
+				throw std::invalid_argument("❌ Closing tag without opened span in markup template.");
+			--depth;
+			operations.push(Operation{Operation::escape, i, 1, depth ? spans[depth - 1] : 0});
+			start = i += 3;
+		} else if (current == '[') {
+			ColorFormat::Attributes added = 0;
+			size_t					end	  = ++i;
+
+			while (end < length and markup[end] != ']')
+				++end;
+			if (end == length)
+				throw std::invalid_argument("❌ Unclosed tag in markup template.");
+			while (i < end) {
+				size_t nameEnd = i;
+				while (nameEnd < end and markup[nameEnd] != ' ')
+					++nameEnd;
+				if (nameEnd > i) {
+					const ColorFormat::Attributes format = ColorFormat::resolveFormat(markup + i, nameEnd - i);
+					if (format == ColorFormat::unknownFormat)
+						throw std::invalid_argument("❌ Unknown format detected in markup template.");
+					if (ColorFormat::conflicting(added, format))
+						throw std::invalid_argument("❌ Conflicting formats in markup tag.");
+					added |= format;
+				}
+				i = nameEnd + 1;
+			}
+			if (!added)
+				throw std::invalid_argument("❌ Empty tag in markup template.");
+			if (depth == maximumDepth)
+				throw std::invalid_argument("❌ Markup spans are nested too deeply.");
+			spans[depth] = ColorFormat::overlay(depth ? spans[depth - 1] : 0, added);
+			++depth;
+			operations.push(Operation{Operation::escape, 0, 0, added});
+			start = i = end + 1;
+		} else
+			++i;
+	}
+	if (depth)
+		throw std::invalid_argument("❌ Unclosed span in markup template.");
+	if (length > start)
+		operations.push(Operation{Operation::literal, start, length - start, 0});
+	return slots;
+}
@@ -0,0 +1,371 @@
+#include "ColorTheme.hpp"
+
+/* ############################################################################################## */
+
+/**
+ * @file ColorTheme.cpp
+ * @brief Implementation of the ColorTheme and ThemeRegistry classes.
+ *
+ * This file contains the theme definitions and the publication of resolved snapshots,
+ * read without locks and reclaimed by epochs.
+ *
+ * @author aheitz
+ * @date Created: 2026-10-17
+ * @date Last Modified: 2026-10-17
+ */
+
+/* ############################################################################################## */
+
+/*
+ * This file is part of the ColorFormat library.
+ *
+ * Copyright (C) 2025 aheitz <alexy.pa.heitz@gmail.com>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+/* ############################################################################################## */
+
+#include <atomic>
+#include <cstring>
+#include <mutex>
+#include <vector>
+
+/* ############################################################################################## */
+
+/**
+ * @brief Defines the formats of a semantic name.
+ *
+ * @param name The semantic name.
+ * @param formats Format names separated by spaces, as accepted by ColorFormat::formatString().
+ * @return ColorTheme& This theme.
+ *
+ * @throws std::invalid_argument If a format is unknown or conflicts with another one.
+ */
+ColorTheme &ColorTheme::define(const std::string &name, const std::string &formats) {
+	ColorFormat::Attributes attributes = 0;
+	size_t					start	   = 0;
+
+	while (start < formats.size()) {
+		size_t end = formats.find(' ', start);
+		if (end == std::string::npos)
+			end = formats.size();
+		if (end > start) {
+			const ColorFormat::Attributes format = ColorFormat::resolveFormat(formats.data() + start, end - start);
+			if (format == ColorFormat::unknownFormat)
+				throw std::invalid_argument("❌ Unknown format detected: " + formats.substr(start, end - start));
+			if (ColorFormat::conflicting(attributes, format))
+				throw std::invalid_argument("❌ Conflicting formats for the theme style: " + name + '.');
+			attributes |= format;
+		}
+		start = end + 1;
+	}
+	return define(name, attributes);
+}
+
+ColorTheme &ColorTheme::define(const std::string &name, const ColorFormat::Attributes attributes) {
+	_styles[name] = attributes;
+	return *this;
+}
+
+/**
+ * @brief Retrieves the formats of a semantic name.
+ *
+ * If the name is not defined, its parents are tried in turn ("metric.good", then "metric").
+ *
+ * @param name The semantic name.
+ * @return ColorFormat::Attributes The formats, or 0 if nothing matches.
+ */
+ColorFormat::Attributes ColorTheme::lookup(const std::string &name) const {
+	std::string candidate = name;
+
+	while (true) {
+		const std::map<std::string, ColorFormat::Attributes>::const_iterator style = _styles.find(candidate);
+		if (style != _styles.end())
+			return style->second;
+
+		const size_t separator = candidate.rfind('.');
+		if (separator == std::string::npos)
+			return 0;
+		candidate.erase(separator);
+	}
+}
+
+const std::map<std::string, ColorFormat::Attributes> &ColorTheme::styles(void) const { return _styles; }
+
+/* ############################################################################################## */
+
+/**
+ * @brief Immutable resolution of a theme, indexed by handle.
+ */
+struct ThemeRegistry::Snapshot {
+	std::vector<Entry>	entries;
+	uint64_t			retiredAt;	 /**< Epoch from which no new reader can reach it */
+	Snapshot			*nextRetired;
+};
+
+/**
+ * @brief Announcement of a reading thread.
+ *
+ * `epoch` holds the epoch observed when the current read began, 0 when the thread is not reading.
+ */
+struct ThemeRegistry::ReaderSlot {
+	std::atomic<uint64_t>	epoch;
+	std::atomic<bool>		owned;
+	ReaderSlot				*next;
+};
+
+/**
+ * @brief Shared state of the registry.
+ */
+struct ThemeRegistry::State {
+	std::atomic<Snapshot *>			current;
+	std::atomic<uint64_t>			epoch;
+	std::atomic<ReaderSlot *>		readers;
+
+	std::mutex						writer;		/**< Serializes registrations and publications */
+	std::vector<std::string>		names;		/**< Semantic name of each handle */
+	std::map<std::string, Handle>	handles;
+	ColorTheme						theme;
+	Snapshot						*retired;
+
+	State(void) : current(new Snapshot()), epoch(1), readers(nullptr), retired(nullptr) {}
+
+	~State(void) {
+		delete current.load();
+		while (retired) {
+			Snapshot *next = retired->nextRetired;
+			delete retired;
+			retired = next;
+		}
+		for (ReaderSlot *slot = readers.load() ; slot ; ) {
+			ReaderSlot *next = slot->next;
+			delete slot;
+			slot = next;
+		}
+	}
+};
+
+/* ############################################################################################## */
+
+ThemeRegistry::State &ThemeRegistry::state(void) {
+	static State state;
+	return state;
+}
+
+/**
+ * @brief Retrieves the reader slot of the calling thread.
+ *
+ * Slots are claimed on the first read of a thread, released when it exits
+ * and reused by later threads. They are never freed while the program runs.
+ *
+ * @return ReaderSlot* The slot owned by the calling thread.
+ */
+ThemeRegistry::ReaderSlot *ThemeRegistry::readerSlot(void) {
+	struct Registration {
+		ReaderSlot *slot;
+
+		~Registration(void) {
+			if (slot)
+				slot->owned.store(false, std::memory_order_release);
+		}
+	};
+	static thread_local Registration registration = {nullptr};
+
+	if (registration.slot)
+		return registration.slot;
+
+	State &registry = state();
+	for (ReaderSlot *slot = registry.readers.load(std::memory_order_acquire) ; slot ; slot = slot->next) {
+		bool expected = false;
+		if (!slot->owned.load(std::memory_order_relaxed) and slot->owned.compare_exchange_strong(expected, true))
+			return registration.slot = slot;
+	}
+
+	ReaderSlot *slot = new ReaderSlot();
+	slot->epoch.store(0);
+	slot->owned.store(true);
+	slot->next = registry.readers.load(std::memory_order_relaxed);
+	while (!registry.readers.compare_exchange_weak(slot->next, slot))
+		;
+	return registration.slot = slot;
+}
+
+/* ############################################################################################## */
+
+/**
+ * @brief Announces a read, then pins the current snapshot.
+ *
+ * The announcement is made before loading the snapshot pointer, so a writer that
+ * replaced the snapshot afterwards sees it and keeps the old snapshot alive.
+ */
+ThemeRegistry::ReadGuard::ReadGuard(void) : _slot(readerSlot()), _nested(false), _snapshot(nullptr) {
+	State &registry = state();
+
+	_nested = _slot->epoch.load(std::memory_order_relaxed) != 0;
+	if (!_nested)
+		_slot->epoch.store(registry.epoch.load());
+	_snapshot = registry.current.load();
+}
+
+ThemeRegistry::ReadGuard::~ReadGuard(void) {
+	if (!_nested)
+		_slot->epoch.store(0, std::memory_order_release);
+}
+
+const ThemeRegistry::Entry *ThemeRegistry::ReadGuard::entry(const Handle handle) const {
+	return handle < _snapshot->entries.size() ? &_snapshot->entries[handle] : nullptr;
+}
+
+/* ############################################################################################## */
+
+/**
+ * @brief Retrieves the handle of a semantic name.
+ *
+ * A new name is resolved right away with the current theme, so its handle is usable immediately.
+ *
+ * @param name The semantic name.
+ * @return Handle The stable identifier of the name.
+ */
+ThemeRegistry::Handle ThemeRegistry::handle(const std::string &name) {
+	State					   &registry = state();
+	std::lock_guard<std::mutex> lock(registry.writer);
+
+	const std::map<std::string, Handle>::const_iterator known = registry.handles.find(name);
+	if (known != registry.handles.end())
+		return known->second;
+
+	const Handle handle = static_cast<Handle>(registry.names.size());
+	registry.names.push_back(name);
+	registry.handles[name] = handle;
+	publishLocked(registry);
+	return handle;
+}
+
+/**
+ * @brief Makes a theme current.
+ *
+ * The names defined by the theme get their handles if they had none.
+ *
+ * @param theme The theme to publish, copied by the registry.
+ */
+void ThemeRegistry::publish(const ColorTheme &theme) {
+	State					   &registry = state();
+	std::lock_guard<std::mutex> lock(registry.writer);
+
+	registry.theme = theme;
+	for (std::map<std::string, ColorFormat::Attributes>::const_iterator style = theme.styles().begin() ; style != theme.styles().end() ; ++style)
+		if (registry.handles.insert(std::make_pair(style->first, static_cast<Handle>(registry.names.size()))).second)
+			registry.names.push_back(style->first);
+	publishLocked(registry);
+}
+
+/**
+ * @brief Resolves every handle with the current theme and swaps the snapshot.
+ *
+ * @param registry The registry state, whose writer lock is held.
+ */
+void ThemeRegistry::publishLocked(State &registry) {
+	Snapshot *snapshot = new Snapshot();
+
+	snapshot->entries.resize(registry.names.size());
+	for (size_t i = 0 ; i < registry.names.size() ; i++) {
+		Entry &entry = snapshot->entries[i];
+		entry.attributes = registry.theme.lookup(registry.names[i]);
+		entry.length	 = static_cast<unsigned char>(ColorFormat::writePrefix(entry.attributes, entry.prefix));
+	}
+	snapshot->retiredAt	  = 0;
+	snapshot->nextRetired = nullptr;
+
+	Snapshot *previous = registry.current.exchange(snapshot);
+	previous->retiredAt	  = registry.epoch.fetch_add(1) + 1;
+	previous->nextRetired = registry.retired;
+	registry.retired	  = previous;
+	reclaimLocked(registry);
+}
+
+void ThemeRegistry::reclaim(void) {
+	State					   &registry = state();
+	std::lock_guard<std::mutex> lock(registry.writer);
+
+	reclaimLocked(registry);
+}
+
+/**
+ * @brief Frees the retired snapshots older than every ongoing read.
+ *
+ * A reader announcing epoch E may hold any snapshot retired after E; snapshots retired
+ * at or before the oldest announced epoch are unreachable.
+ *
+ * @param registry The registry state, whose writer lock is held.
+ */
+void ThemeRegistry::reclaimLocked(State &registry) {
+	uint64_t oldest = registry.epoch.load();
+
+	for (ReaderSlot *slot = registry.readers.load() ; slot ; slot = slot->next) {
+		const uint64_t epoch = slot->epoch.load();
+		if (epoch and epoch < oldest)
+			oldest = epoch;
+	}
+
+	Snapshot **link = &registry.retired;
+	while (*link) {
+		if ((*link)->retiredAt <= oldest) {
+			Snapshot *reclaimed = *link;
+			*link = reclaimed->nextRetired;
+			delete reclaimed;
+		} else
+			link = &(*link)->nextRetired;
+	}
+}
+
+/* ############################################################################################## */
+
+ColorFormat::Attributes ThemeRegistry::attributes(const Handle handle) {
+	const ReadGuard guard;
+	const Entry		*entry = guard.entry(handle);
+
+	return entry ? entry->attributes : 0;
+}
+
+size_t ThemeRegistry::writePrefix(const Handle handle, char *buffer) {
+	const ReadGuard guard;
+	const Entry		*entry = guard.entry(handle);
+
+	if (!entry)
+		return 0;
+	std::memcpy(buffer, entry->prefix, entry->length);
+	return entry->length;
+}
+
+/**
+ * @brief Wraps a text with the current style of a handle.
+ *
+ * @param handle The semantic style.
+ * @param text The text to style.
+ * @return std::string The prefix, the text and a reset, or the text alone if the style is empty.
+ */
+std::string ThemeRegistry::format(const Handle handle, const std::string &text) {
+	const ReadGuard guard;
+	const Entry		*entry = guard.entry(handle);
+	std::string		result;
+
+	if (!entry or !entry->attributes)
+		return text;
+	result.reserve(entry->length + text.size() + 4);
+	result.append(entry->prefix, entry->length);
+	result += text;
+	result += "\033[0m";
+	return result;
+}
@@ -0,0 +1,162 @@
+#pragma once
+
+/* ############################################################################################## */
+
+/**
+ * @file ColorTheme.hpp
+ * @brief Declaration of the ColorTheme and ThemeRegistry classes for semantic styling.
+ *
+ * Call sites style text by meaning ("error", "metric.good", "id") through stable handles,
+ * while the theme mapping those meanings to formats can be replaced at runtime:
+ * ```
+ * static const ThemeRegistry::Handle error = ThemeRegistry::handle("error");
+ * std::cout << ThemeRegistry::format(error, "disk full") << std::endl;
+ *
+ * ThemeRegistry::publish(ColorTheme().define("error", "bright_red bold"));
+ * ```
+ * Reading the current theme never locks: a published theme is an immutable snapshot
+ * reached through an atomic pointer, and replaced snapshots are only freed once no
+ * reader can still hold them (epoch-based reclamation).
+ *
+ * Requires C++11.
+ *
+ * @author aheitz
+ * @date Created: 2026-10-17
+ * @date Last Modified: 2026-10-17
+ */
+
+/* ############################################################################################## */
+
+/*
+ * This file is part of the ColorFormat library.
+ *
+ * Copyright (C) 2025 aheitz <alexy.pa.heitz@gmail.com>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+/* ############################################################################################## */
+
+#include "ColorFormat.hpp"
+
+#include <map>
+#include <string>
+
+/* ############################################################################################## */
+
+/**
+ * @brief Mapping of semantic names to formats.
+ *
+ * Names are hierarchical: an undefined "metric.good" falls back to "metric".
+ */
+class ColorTheme {
+	private:
+		std::map<std::string, ColorFormat::Attributes> _styles;
+	public:
+		/**
+		 * @brief Defines the formats of a semantic name.
+		 * @param name The semantic name (e.g. "error", "metric.good").
+		 * @param formats Format names separated by spaces (e.g. "bright_red bold").
+		 * @return This theme, to chain the definitions.
+		 * @throws std::invalid_argument if a format is unknown or conflicts with another.
+		 */
+		ColorTheme &define(const std::string &name, const std::string &formats);
+
+		/**
+		 * @brief Defines the formats of a semantic name from resolved attributes.
+		 */
+		ColorTheme &define(const std::string &name, ColorFormat::Attributes attributes);
+
+		/**
+		 * @brief Retrieves the formats of a semantic name, or of its closest defined parent.
+		 * @return The attributes, or 0 if neither the name nor its parents are defined.
+		 */
+		ColorFormat::Attributes lookup(const std::string &name) const;
+
+		/**
+		 * @brief Retrieves all the defined names and their formats.
+		 */
+		const std::map<std::string, ColorFormat::Attributes> &styles(void) const;
+};
+
+/* ############################################################################################## */
+
+/**
+ * @brief Process-wide current theme, resolved for lock-free lookups.
+ */
+class ThemeRegistry {
+	public:
+		/** Stable identifier of a semantic name, valid across theme swaps. */
+		typedef unsigned int Handle;
+
+		/** Resolved style of a handle in a published snapshot. */
+		struct Entry {
+			ColorFormat::Attributes attributes;
+			unsigned char			length;
+			char					prefix[ColorFormat::prefixCapacity];
+		};
+
+		/**
+		 * @brief Retrieves the handle of a semantic name, registering it on first use.
+		 *
+		 * Registration takes a lock: call sites should keep their handles.
+		 */
+		static Handle handle(const std::string &name);
+
+		/**
+		 * @brief Makes a theme current.
+		 *
+		 * Every registered name is resolved once, together with its escape prefix. Readers
+		 * see either the previous or the new snapshot, never a mix of both.
+		 */
+		static void publish(const ColorTheme &theme);
+
+		/** @name Lock-free lookups */
+		/** @{ */
+		static ColorFormat::Attributes attributes(Handle handle);
+		/** Copies the precomputed prefix into a buffer of at least ColorFormat::prefixCapacity bytes. */
+		static size_t writePrefix(Handle handle, char *buffer);
+		/** Wraps a text with the prefix of a handle and a reset (the text is not stripped of its escapes). */
+		static std::string format(Handle handle, const std::string &text);
+		/** @} */
+
+		/**
+		 * @brief Frees the replaced snapshots that no reader can still access.
+		 *
+		 * Called by publish(); exposed for programs that want to release memory sooner.
+		 */
+		static void reclaim(void);
+	private:
+		struct Snapshot;
+		struct ReaderSlot;
+		struct State;
+
+		/** Pins the current snapshot for the lifetime of a lookup. */
+		class ReadGuard {
+			private:
+				ReaderSlot		*_slot;
+				bool			_nested;
+				const Snapshot	*_snapshot;
+			public:
+				ReadGuard(void);
+				~ReadGuard(void);
+
+				const Entry *entry(Handle handle) const;
+		};
+
+		static State &state(void);
+		static ReaderSlot *readerSlot(void);
+		static void publishLocked(State &state);
+		static void reclaimLocked(State &state);
+};
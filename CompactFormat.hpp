@@ -0,0 +1,134 @@
+#pragma once
+
+/* ############################################################################################## */
+
+/**
+ * @file CompactFormat.hpp
+ * @brief Declaration of the CompactFormat class, a formatted text kept as a view and its attributes.
+ *
+ * A ColorFormat owns its escaped text in a std::string. When millions of formatted values
+ * are kept (e.g. a ring buffer of recent log events), a CompactFormat only keeps a pointer
+ * to the text, its length and the attributes, and formats on demand:
+ * ```
+ * static const std::string diskFull = "disk full";
+ * const CompactFormat event(diskFull, ColorFormat::red | ColorFormat::bold);
+ * std::cout << event << std::endl;
+ * ```
+ * The text is not copied: it must be interned or owned by an arena that outlives the object.
+ *
+ * @author aheitz
+ * @date Created: 2026-10-17
+ * @date Last Modified: 2026-10-17
+ */
+
+/* ############################################################################################## */
+
+/*
+ * This file is part of the ColorFormat library.
+ *
+ * Copyright (C) 2025 aheitz <alexy.pa.heitz@gmail.com>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+/* ############################################################################################## */
+
+#include "ColorFormat.hpp"
+
+#include <cstring>
+#include <ostream>
+#include <stdexcept>
+#include <stdint.h>
+#include <string>
+#if __cplusplus >= 201703L
+# include <string_view>
+#endif
+
+/* ############################################################################################## */
+
+/**
+ * @brief View of a text with its formats, rendered each time it is written.
+ *
+ * Its footprint is a pointer, a 32-bit length and the 64-bit attributes (24 bytes on
+ * 64-bit systems), against a ColorFormat and the heap block of its escaped text.
+ * The output is the one of formatString() with the same formats.
+ */
+class CompactFormat {
+	private:
+		const char				*_text;
+		uint32_t				_length;
+		ColorFormat::Attributes	_attributes;
+
+		static uint32_t checkedLength(const size_t length) {
+			if (length > 0xFFFFFFFFu)
+				throw std::length_error("❌ A compact format holds at most 4 GiB of text.");
+			return static_cast<uint32_t>(length);
+		}
+	public:
+		CompactFormat(void) : _text(""), _length(0), _attributes(0) {}
+
+		/**
+		 * @brief Keeps a view of a text given by its start and length.
+		 *
+		 * The attributes come first, so that `CompactFormat("text", ColorFormat::red)` cannot
+		 * take them for a length.
+		 *
+		 * @throws std::length_error if the text is 4 GiB or longer.
+		 */
+		CompactFormat(const ColorFormat::Attributes attributes, const char *text, const size_t length)
+			: _text(text), _length(checkedLength(length)), _attributes(attributes) {}
+
+		/** Keeps a view of a null-terminated text, such as a literal. */
+		CompactFormat(const char *text, const ColorFormat::Attributes attributes = 0)
+			: _text(text), _length(checkedLength(std::strlen(text))), _attributes(attributes) {}
+
+		/** Keeps a view of the string, which must not be modified or destroyed while in use. */
+		explicit CompactFormat(const std::string &text, const ColorFormat::Attributes attributes = 0)
+			: _text(text.data()), _length(checkedLength(text.size())), _attributes(attributes) {}
+#if __cplusplus >= 201103L
+		/** A temporary string would be destroyed before the view is rendered. */
+		CompactFormat(std::string &&text, ColorFormat::Attributes attributes = 0) = delete;
+#endif
+
+#if __cplusplus >= 201703L
+		explicit CompactFormat(const std::string_view text, const ColorFormat::Attributes attributes = 0)
+			: _text(text.data()), _length(checkedLength(text.size())), _attributes(attributes) {}
+#endif
+
+		const char *text(void) const { return _text; }
+		size_t length(void) const { return _length; }
+		ColorFormat::Attributes attributes(void) const { return _attributes; }
+
+		/** @name Rendering */
+		/** @{ */
+		/** Appends the formatted text to any string type, or to a BufferedWriter. */
+		template <typename String>
+		String &append(String &output) const {
+			ColorFormat::appendFormatted(output, _text, _length, _attributes);
+			return output;
+		}
+
+		std::string str(void) const {
+			std::string output;
+			return append(output);
+		}
+
+		/** Renders in place, on the heap only beyond 256 bytes. */
+		friend std::ostream &operator<<(std::ostream &stream, const CompactFormat &format) {
+			InlineString<256> output;
+			format.append(output);
+			return stream.write(output.data(), static_cast<std::streamsize>(output.size()));
+		}
+		/** @} */
+};
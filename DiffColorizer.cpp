@@ -0,0 +1,496 @@
+#include "DiffColorizer.hpp"
+
+/* ############################################################################################## */
+
+/**
+ * @file DiffColorizer.cpp
+ * @brief Implementation of the DiffColorizer class.
+ *
+ * This file contains the classification of lines, which follows the line counts of the hunk
+ * headers to tell file headers from removed and added lines, and the word highlighting.
+ *
+ * @author aheitz
+ * @date Created: 2026-10-17
+ * @date Last Modified: 2026-10-17
+ */
+
+/* ############################################################################################## */
+
+/*
+ * This file is part of the ColorFormat library.
+ *
+ * Copyright (C) 2025 aheitz <alexy.pa.heitz@gmail.com>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+/* ############################################################################################## */
+
+#include <cctype>
+#include <cstring>
+
+/* ############################################################################################## */
+
+DiffColorizer::DiffColorizer(BufferedWriter &output)
+	: _output(output), _highlight(ColorFormat::inverse), _highlightWords(false), _current(noColor), _kind(kindCount),
+	  _headLength(0), _oldRemaining(0), _newRemaining(0), _hunkField(4), _hunkDigits(false),
+	  _block(NULL), _changed(NULL), _blockLength(0), _removedLines(0), _addedLines(0), _overflow(false), _buffering(false),
+	  _lengths(NULL) {
+	_palette[headerLine]  = ColorFormat::bold;
+	_palette[hunkLine]	  = ColorFormat::cyan;
+	_palette[removedLine] = ColorFormat::red;
+	_palette[addedLine]	  = ColorFormat::green;
+	_palette[contextLine] = 0;
+	_palette[otherLine]	  = 0;
+	_palette[noColor]	  = 0;
+	prepareTransitions();
+}
+
+DiffColorizer::~DiffColorizer(void) {
+	delete[] _block;
+	delete[] _changed;
+	delete[] _lengths;
+}
+
+DiffColorizer &DiffColorizer::color(const LineKind kind, const ColorFormat::Attributes attributes) {
+	_palette[kind] = attributes;
+	prepareTransitions();
+	return *this;
+}
+
+ColorFormat::Attributes DiffColorizer::color(const LineKind kind) const { return _palette[kind]; }
+
+/**
+ * @brief Enables or disables word highlighting.
+ *
+ * The buffers of the groups of lines are allocated the first time it is enabled.
+ */
+DiffColorizer &DiffColorizer::highlightWords(const bool enabled, const ColorFormat::Attributes attributes) {
+	if (enabled and !_block) {
+		_block	 = new char[blockCapacity];
+		_changed = new unsigned char[blockCapacity];
+		_lengths = new unsigned short[(maximumWords + 1) * (maximumWords + 1)];
+	}
+	_highlightWords = enabled;
+	_highlight		= attributes;
+	prepareTransitions();
+	return *this;
+}
+
+/**
+ * @brief Precomputes the escape sequences between every pair of states.
+ */
+void DiffColorizer::prepareTransitions(void) {
+	_palette[removedHighlight] = ColorFormat::overlay(_palette[removedLine], _highlight);
+	_palette[addedHighlight]   = ColorFormat::overlay(_palette[addedLine], _highlight);
+	for (size_t from = 0 ; from < stateCount ; from++)
+		for (size_t to = 0 ; to < stateCount ; to++)
+			_transitionLengths[from][to] = static_cast<unsigned char>(ColorFormat::writeTransition(_palette[from], _palette[to], _transitions[from][to]));
+}
+
+/**
+ * @brief Applies the color of a state, writing only what changes from the current one.
+ */
+void DiffColorizer::switchTo(const size_t state) {
+	if (state != _current) {
+		_output.append(_transitions[_current][state], _transitionLengths[_current][state]);
+		_current = state;
+	}
+}
+
+/* ############################################################################################## */
+
+/**
+ * @brief Finds the kind of a line from its first bytes.
+ *
+ * Inside a hunk, the counts of its header tell how many removed, added and context lines
+ * follow, so that a removed line starting with `--` is not taken for a file header.
+ */
+size_t DiffColorizer::classify(const char *head, const size_t length) {
+	if (_oldRemaining or _newRemaining) {
+		switch (head[0]) {
+			case '-':
+				if (_oldRemaining) {
+					_oldRemaining--;
+					return removedLine;
+				}
+				break;
+			case '+':
+				if (_newRemaining) {
+					_newRemaining--;
+					return addedLine;
+				}
+				break;
+			case ' ':
+			case '\n':
+				/* Some tools strip the space of empty context lines */
+				_oldRemaining -= _oldRemaining != 0;
+				_newRemaining -= _newRemaining != 0;
+				return contextLine;
+			case '\\':
+				return otherLine;
+		}
+		_oldRemaining = _newRemaining = 0;
+	}
+	if (length >= 2 and head[0] == '@' and head[1] == '@')
+		return hunkLine;
+	if (length == headSize and (!std::memcmp(head, "--- ", 4) or !std::memcmp(head, "+++ ", 4)
+								or !std::memcmp(head, "diff", 4) or !std::memcmp(head, "inde", 4)))
+		return headerLine;
+	switch (head[0]) {
+		case '-':
+			return removedLine;
+		case '+':
+			return addedLine;
+		case ' ':
+			return contextLine;
+		default:
+			return otherLine;
+	}
+}
+
+/**
+ * @brief Starts a classified line.
+ *
+ * With word highlighting, removed lines and the added lines that follow them are kept in
+ * a group until the group ends.
+ */
+void DiffColorizer::startLine(const size_t kind) {
+	if (_highlightWords and ((kind == removedLine and _addedLines) or (kind != removedLine and kind != addedLine))) {
+		flushBlock();
+		_overflow = false;
+	}
+	_kind	   = kind;
+	_buffering = _highlightWords and !_overflow and (kind == removedLine or (kind == addedLine and _removedLines));
+	if (!_buffering)
+		switchTo(kind);
+	if (kind == hunkLine) {
+		_hunkValues[0] = _hunkValues[2] = 0;
+		_hunkValues[1] = _hunkValues[3] = 1;
+		_hunkField	   = 0;
+		_hunkDigits	   = false;
+	}
+}
+
+/**
+ * @brief Reads the line counts of a hunk header: `@@ -oldStart[,oldCount] +newStart[,newCount] @@`.
+ *
+ * A missing count is 1.
+ */
+void DiffColorizer::readHunk(const char *data, const size_t length) {
+	for (size_t i = 0 ; i < length and _hunkField < 4 ; i++) {
+		const char character = data[i];
+
+		if (character >= '0' and character <= '9') {
+			_hunkValues[_hunkField] = _hunkValues[_hunkField] * 10 + static_cast<unsigned long>(character - '0');
+			_hunkDigits				= true;
+		} else if (character == ',' and _hunkDigits) {
+			_hunkField				|= 1;
+			_hunkValues[_hunkField] = 0;
+		} else if (character == ' ' and _hunkDigits) {
+			_hunkField	= (_hunkField & 2) + 2;
+			_hunkDigits = false;
+		}
+	}
+}
+
+/**
+ * @brief Handles bytes of the current line, the last one being its newline if it ends.
+ */
+void DiffColorizer::content(const char *data, const size_t length) {
+	const bool ends = data[length - 1] == '\n';
+
+	if (_kind == hunkLine)
+		readHunk(data, length);
+	if (_buffering and _blockLength + length > static_cast<size_t>(blockCapacity)) {
+		/* The group does not fit: what is kept is written and the rest of the group streams */
+		flushBlock();
+		_overflow  = true;
+		_buffering = false;
+		switchTo(_kind);
+	}
+	if (_buffering) {
+		std::memcpy(_block + _blockLength, data, length);
+		_blockLength += length;
+		if (ends) {
+			_lineEnds[_removedLines + _addedLines] = _blockLength;
+			(_kind == removedLine ? _removedLines : _addedLines)++;
+			if (_removedLines + _addedLines == static_cast<size_t>(maximumBlockLines)) {
+				flushBlock();
+				_overflow = true;
+			}
+		}
+	} else
+		_output.append(data, length);
+	if (ends) {
+		if (_kind == hunkLine) {
+			_oldRemaining = _hunkValues[1];
+			_newRemaining = _hunkValues[3];
+		}
+		_kind = kindCount;
+	}
+}
+
+/* ############################################################################################## */
+
+/**
+ * @brief Colors the next chunk of the diff.
+ *
+ * The first bytes of each line are gathered to classify it, even across chunks; the rest
+ * of the line is found with memchr() and copied as a block.
+ *
+ * @param data The chunk, which can end anywhere in the diff.
+ * @param length The size of the chunk.
+ */
+void DiffColorizer::write(const char *data, const size_t length) {
+	size_t i = 0;
+
+	while (i < length) {
+		if (_kind == kindCount) {
+			while (_headLength < static_cast<size_t>(headSize) and i < length)
+				if ((_head[_headLength++] = data[i++]) == '\n')
+					break;
+			if (_headLength < static_cast<size_t>(headSize) and _head[_headLength - 1] != '\n')
+				return;
+
+			const size_t headLength = _headLength;
+
+			_headLength = 0;
+			startLine(classify(_head, headLength));
+			content(_head, headLength);
+			continue;
+		}
+
+		const char	*newline = static_cast<const char *>(std::memchr(data + i, '\n', length - i));
+		const size_t end	 = newline ? static_cast<size_t>(newline - data) + 1 : length;
+
+		content(data + i, end - i);
+		i = end;
+	}
+}
+
+/**
+ * @brief Ends the diff.
+ *
+ * A last line too short to be classified is classified with what it has, the kept group
+ * is written and the terminal is reset.
+ */
+void DiffColorizer::finish(void) {
+	if (_kind == kindCount and _headLength) {
+		const size_t headLength = _headLength;
+
+		_headLength = 0;
+		startLine(classify(_head, headLength));
+		content(_head, headLength);
+	}
+	flushBlock();
+	switchTo(noColor);
+	_kind		   = kindCount;
+	_headLength	   = 0;
+	_oldRemaining  = 0;
+	_newRemaining  = 0;
+	_hunkField	   = 4;
+	_hunkDigits	   = false;
+	_blockLength   = 0;
+	_removedLines  = 0;
+	_addedLines	   = 0;
+	_overflow	   = false;
+	_buffering	   = false;
+}
+
+/* ############################################################################################## */
+
+/**
+ * @brief Writes the kept group: the changed words of each removed line and of the added
+ * line at the same position in the group are highlighted.
+ *
+ * A line still being read (when the group overflows) is written as is.
+ */
+void DiffColorizer::flushBlock(void) {
+	if (!_blockLength)
+		return;
+
+	const size_t lines = _removedLines + _addedLines;
+	const size_t pairs = _removedLines < _addedLines ? _removedLines : _addedLines;
+	size_t		 start = 0;
+
+	std::memset(_changed, 0, _blockLength);
+	for (size_t pair = 0 ; pair < pairs ; pair++)
+		comparePair(pair ? _lineEnds[pair - 1] : 0, _lineEnds[pair], _lineEnds[_removedLines + pair - 1], _lineEnds[_removedLines + pair]);
+	for (size_t line = 0 ; line < lines ; line++) {
+		writeLine(line < _removedLines ? removedLine : addedLine, start, _lineEnds[line]);
+		start = _lineEnds[line];
+	}
+	if (start < _blockLength)
+		writeLine(_kind, start, _blockLength);
+	_blockLength  = 0;
+	_removedLines = 0;
+	_addedLines	  = 0;
+}
+
+/**
+ * @brief Splits a line into words: runs of letters, digits, underscores and UTF-8 bytes,
+ * runs of blanks, or single punctuation characters.
+ *
+ * @param bounds Receives the start of each word, then the end of the last one.
+ * @return The number of words, or maximum + 1 if there are more.
+ */
+static size_t splitWords(const char *line, const size_t length, size_t *bounds, const size_t maximum) {
+	size_t words = 0;
+
+	for (size_t i = 0 ; i < length ; ) {
+		if (words == maximum)
+			return maximum + 1;
+		bounds[words++] = i;
+
+		const unsigned char first = static_cast<unsigned char>(line[i++]);
+
+		if (std::isalnum(first) or first == '_' or first >= 0x80)
+			while (i < length and (std::isalnum(static_cast<unsigned char>(line[i])) or line[i] == '_' or static_cast<unsigned char>(line[i]) >= 0x80))
+				i++;
+		else if (first == ' ' or first == '\t')
+			while (i < length and (line[i] == ' ' or line[i] == '\t'))
+				i++;
+	}
+	bounds[words] = length;
+	return words;
+}
+
+static inline bool sameWord(const char *first, const size_t *firstBounds, const size_t firstWord,
+							const char *second, const size_t *secondBounds, const size_t secondWord) {
+	const size_t length = firstBounds[firstWord + 1] - firstBounds[firstWord];
+
+	return length == secondBounds[secondWord + 1] - secondBounds[secondWord]
+		   and !std::memcmp(first + firstBounds[firstWord], second + secondBounds[secondWord], length);
+}
+
+/**
+ * @brief Marks the changed words of a removed line and of its added counterpart.
+ *
+ * The common first and last words are skipped, then the longest common subsequence of the
+ * remaining words is computed in the fixed table. Lines with too many words have their whole
+ * middle marked; lines with no word in common are not highlighted at all.
+ */
+void DiffColorizer::comparePair(size_t removedStart, size_t removedEnd, size_t addedStart, size_t addedEnd) {
+	/* The marker and the newline are not compared */
+	removedStart++;
+	addedStart++;
+	removedEnd -= removedEnd > removedStart and _block[removedEnd - 1] == '\n';
+	addedEnd   -= addedEnd > addedStart and _block[addedEnd - 1] == '\n';
+
+	const char *removed = _block + removedStart;
+	const char *added	= _block + addedStart;
+	size_t		removedLength = removedEnd - removedStart;
+	size_t		addedLength	  = addedEnd - addedStart;
+	size_t		prefix = 0;
+
+	/* Common bytes on both ends are skipped, backing off to the start of a word */
+	while (prefix < removedLength and prefix < addedLength and removed[prefix] == added[prefix])
+		prefix++;
+	while (prefix and (std::isalnum(static_cast<unsigned char>(removed[prefix - 1])) or removed[prefix - 1] == '_'
+					   or static_cast<unsigned char>(removed[prefix - 1]) >= 0x80))
+		prefix--;
+
+	size_t suffix = 0;
+
+	while (suffix < removedLength - prefix and suffix < addedLength - prefix
+		   and removed[removedLength - 1 - suffix] == added[addedLength - 1 - suffix])
+		suffix++;
+	while (suffix and (std::isalnum(static_cast<unsigned char>(removed[removedLength - suffix])) or removed[removedLength - suffix] == '_'
+					   or static_cast<unsigned char>(removed[removedLength - suffix]) >= 0x80))
+		suffix--;
+	removed		  += prefix;
+	added		  += prefix;
+	removedLength -= prefix + suffix;
+	addedLength	  -= prefix + suffix;
+
+	size_t		 removedBounds[maximumWords + 1];
+	size_t		 addedBounds[maximumWords + 1];
+	const size_t removedWords = splitWords(removed, removedLength, removedBounds, maximumWords);
+	const size_t addedWords	  = splitWords(added, addedLength, addedBounds, maximumWords);
+	unsigned char *const removedChanged = _changed + (removed - _block);
+	unsigned char *const addedChanged	= _changed + (added - _block);
+
+	if (removedWords > static_cast<size_t>(maximumWords) or addedWords > static_cast<size_t>(maximumWords)) {
+		std::memset(removedChanged, 1, removedLength);
+		std::memset(addedChanged, 1, addedLength);
+		return;
+	}
+
+	/* lengths[i][j]: length of the common subsequence of the words from i and from j */
+	const size_t	width	= addedWords + 1;
+	unsigned short *lengths = _lengths;
+
+	for (size_t j = 0 ; j <= addedWords ; j++)
+		lengths[removedWords * width + j] = 0;
+	for (size_t i = removedWords ; i-- ; ) {
+		lengths[i * width + addedWords] = 0;
+		for (size_t j = addedWords ; j-- ; )
+			if (sameWord(removed, removedBounds, i, added, addedBounds, j))
+				lengths[i * width + j] = static_cast<unsigned short>(lengths[(i + 1) * width + j + 1] + 1);
+			else
+				lengths[i * width + j] = lengths[(i + 1) * width + j] > lengths[i * width + j + 1] ? lengths[(i + 1) * width + j] : lengths[i * width + j + 1];
+	}
+	if (!lengths[0] and !prefix and !suffix)
+		return;
+
+	size_t i = 0;
+	size_t j = 0;
+
+	while (i < removedWords or j < addedWords) {
+		if (i < removedWords and j < addedWords and sameWord(removed, removedBounds, i, added, addedBounds, j)) {
+			i++;
+			j++;
+		} else if (j == addedWords or (i < removedWords and lengths[(i + 1) * width + j] >= lengths[i * width + j + 1])) {
+			std::memset(removedChanged + removedBounds[i], 1, removedBounds[i + 1] - removedBounds[i]);
+			i++;
+		} else {
+			std::memset(addedChanged + addedBounds[j], 1, addedBounds[j + 1] - addedBounds[j]);
+			j++;
+		}
+	}
+}
+
+/**
+ * @brief Writes a line of the kept group, switching to the highlight around changed words.
+ */
+void DiffColorizer::writeLine(const size_t kind, size_t start, const size_t end) {
+	const size_t highlight = kind == removedLine ? removedHighlight : addedHighlight;
+
+	while (start < end) {
+		const unsigned char changed = _changed[start];
+		size_t				run		= start + 1;
+
+		while (run < end and _changed[run] == changed)
+			run++;
+		switchTo(changed ? highlight : kind);
+		_output.append(_block + start, run - start);
+		start = run;
+	}
+}
+
+/* ############################################################################################## */
+
+void DiffColorizer::colorize(std::istream &input, std::ostream &output, const bool highlight) {
+	BufferedWriter writer(output);
+	DiffColorizer  colorizer(writer);
+	char		   chunk[1 << 14];
+
+	colorizer.highlightWords(highlight);
+	do {
+		input.read(chunk, sizeof(chunk));
+		colorizer.write(chunk, static_cast<size_t>(input.gcount()));
+	} while (input);
+	colorizer.finish();
+}
@@ -0,0 +1,156 @@
+#pragma once
+
+/* ############################################################################################## */
+
+/**
+ * @file DiffColorizer.hpp
+ * @brief Declaration of the DiffColorizer class, which colors unified diffs as they stream.
+ *
+ * Lines are classified by their first bytes (`+`, `-`, `@@`, space, file headers) and an
+ * escape sequence is only written where the kind of line changes, once per run of lines:
+ * ```
+ * BufferedWriter output(std::cout);
+ * DiffColorizer  colorizer(output);
+ * while (receive(chunk))
+ *     colorizer.write(chunk.data(), chunk.size());
+ * colorizer.finish();
+ * ```
+ * With highlightWords(), the words changed between paired removed and added lines are
+ * highlighted, from a longest common subsequence computed in fixed-size buffers.
+ *
+ * @author aheitz
+ * @date Created: 2026-10-17
+ * @date Last Modified: 2026-10-17
+ */
+
+/* ############################################################################################## */
+
+/*
+ * This file is part of the ColorFormat library.
+ *
+ * Copyright (C) 2025 aheitz <alexy.pa.heitz@gmail.com>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+/* ############################################################################################## */
+
+#include "BufferedWriter.hpp"
+#include "ColorFormat.hpp"
+
+#include <istream>
+#include <ostream>
+
+/* ############################################################################################## */
+
+/**
+ * @brief Streaming unified diff colorizer, with optional word highlighting.
+ */
+class DiffColorizer {
+	public:
+		enum LineKind {
+			headerLine,		/**< `diff`, `index`, `---` and `+++` lines outside hunks */
+			hunkLine,		/**< `@@ -a,b +c,d @@` */
+			removedLine,
+			addedLine,
+			contextLine,
+			otherLine,		/**< `\ No newline at end of file` and anything else */
+			kindCount
+		};
+
+		enum {
+			/** Largest group of removed then added lines kept to highlight words; larger groups are written plainly */
+			blockCapacity = 64 << 10,
+			maximumBlockLines = 256,
+			/** Most words per line compared; longer lines are highlighted between their common prefix and suffix */
+			maximumWords = 256
+		};
+
+		/**
+		 * @brief Creates a colorizer with the default colors: bold headers, cyan hunk headers,
+		 * red removed lines, green added lines and inverse changed words.
+		 */
+		explicit DiffColorizer(BufferedWriter &output);
+		~DiffColorizer(void);
+
+		/** @name Settings */
+		/** @{ */
+		DiffColorizer &color(LineKind kind, ColorFormat::Attributes attributes);
+		ColorFormat::Attributes color(LineKind kind) const;
+		/** Highlights changed words with the given attributes, overlaid on the color of their line. */
+		DiffColorizer &highlightWords(bool enabled, ColorFormat::Attributes attributes = ColorFormat::inverse);
+		/** @} */
+
+		/** Colors the next chunk of the diff. */
+		void write(const char *data, size_t length);
+
+		/** Ends the diff, writing the lines kept for highlighting and resetting the terminal. */
+		void finish(void);
+
+		/**
+		 * @brief Colors a whole stream, read in chunks.
+		 */
+		static void colorize(std::istream &input, std::ostream &output, bool highlight = false);
+	private:
+		enum {
+			removedHighlight = kindCount,
+			addedHighlight,
+			noColor,
+			stateCount,
+			/** Bytes needed to classify a line */
+			headSize = 4
+		};
+
+		BufferedWriter			&_output;
+		ColorFormat::Attributes	_palette[stateCount];
+		ColorFormat::Attributes	_highlight;
+		unsigned char			_transitionLengths[stateCount][stateCount];
+		char					_transitions[stateCount][stateCount][ColorFormat::transitionCapacity];
+		bool					_highlightWords;
+
+		/* State kept between chunks */
+		size_t			_current;		/**< State whose color is applied */
+		size_t			_kind;			/**< Kind of the current line, kindCount before it is classified */
+		char			_head[headSize];
+		size_t			_headLength;
+		unsigned long	_oldRemaining;	/**< Lines left in the hunk on each side */
+		unsigned long	_newRemaining;
+		unsigned long	_hunkValues[4];	/**< Numbers of the hunk header being read */
+		size_t			_hunkField;
+		bool			_hunkDigits;
+
+		/* Group of removed then added lines, for word highlighting, allocated by highlightWords() */
+		char			*_block;
+		unsigned char	*_changed;		/**< Non-zero for each byte of the group in a changed word */
+		size_t			_blockLength;
+		size_t			_lineEnds[maximumBlockLines];
+		size_t			_removedLines;
+		size_t			_addedLines;
+		bool			_overflow;		/**< The group did not fit: its lines are written as they come */
+		bool			_buffering;		/**< The current line is kept in the group */
+		unsigned short	*_lengths;		/**< (maximumWords + 1)² table of common subsequence lengths */
+
+		void prepareTransitions(void);
+		void switchTo(size_t state);
+		size_t classify(const char *head, size_t length);
+		void startLine(size_t kind);
+		void content(const char *data, size_t length);
+		void readHunk(const char *data, size_t length);
+		void flushBlock(void);
+		void comparePair(size_t removedStart, size_t removedEnd, size_t addedStart, size_t addedEnd);
+		void writeLine(size_t kind, size_t start, size_t end);
+
+		DiffColorizer(const DiffColorizer &source);
+		DiffColorizer &operator=(const DiffColorizer &source);
+};
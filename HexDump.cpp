@@ -0,0 +1,321 @@
+#include "HexDump.hpp"
+
+/* ############################################################################################## */
+
+/**
+ * @file HexDump.cpp
+ * @brief Implementation of the HexDump class.
+ *
+ * This file contains the classification of the bytes and the writing of the dump lines.
+ *
+ * @author aheitz
+ * @date Created: 2026-10-17
+ * @date Last Modified: 2026-10-17
+ */
+
+/* ############################################################################################## */
+
+/*
+ * This file is part of the ColorFormat library.
+ *
+ * Copyright (C) 2025 aheitz <alexy.pa.heitz@gmail.com>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+/* ############################################################################################## */
+
+#include <cstring>
+#include <stdint.h>
+#ifdef __SSE2__
+# include <emmintrin.h>
+#endif
+#ifdef __SSSE3__
+# include <tmmintrin.h>
+#endif
+
+/* ############################################################################################## */
+
+/**
+ * @brief Hexadecimal digits of every byte value, two characters each.
+ */
+const char HexDump::_hexDigits[513] =
+	"000102030405060708090a0b0c0d0e0f101112131415161718191a1b1c1d1e1f"
+	"202122232425262728292a2b2c2d2e2f303132333435363738393a3b3c3d3e3f"
+	"404142434445464748494a4b4c4d4e4f505152535455565758595a5b5c5d5e5f"
+	"606162636465666768696a6b6c6d6e6f707172737475767778797a7b7c7d7e7f"
+	"808182838485868788898a8b8c8d8e8f909192939495969798999a9b9c9d9e9f"
+	"a0a1a2a3a4a5a6a7a8a9aaabacadaeafb0b1b2b3b4b5b6b7b8b9babbbcbdbebf"
+	"c0c1c2c3c4c5c6c7c8c9cacbcccdcecfd0d1d2d3d4d5d6d7d8d9dadbdcdddedf"
+	"e0e1e2e3e4e5e6e7e8e9eaebecedeeeff0f1f2f3f4f5f6f7f8f9fafbfcfdfeff";
+
+/* ############################################################################################## */
+
+HexDump::HexDump(void) {
+	_palette[nulByte]		 = ColorFormat::brightBlack;
+	_palette[printableByte]	 = ColorFormat::cyan;
+	_palette[whitespaceByte] = ColorFormat::green;
+	_palette[controlByte]	 = ColorFormat::magenta;
+	_palette[highByte]		 = ColorFormat::yellow;
+	_palette[classCount]	 = 0;
+	prepareTransitions();
+}
+
+HexDump &HexDump::color(const ByteClass byteClass, const ColorFormat::Attributes attributes) {
+	_palette[byteClass] = attributes;
+	prepareTransitions();
+	return *this;
+}
+
+ColorFormat::Attributes HexDump::color(const ByteClass byteClass) const { return _palette[byteClass]; }
+
+/**
+ * @brief Precomputes the escape sequences between the colors of every pair of classes.
+ */
+void HexDump::prepareTransitions(void) {
+	for (size_t from = 0 ; from <= classCount ; from++)
+		for (size_t to = 0 ; to < classCount ; to++)
+			_transitionLengths[from][to] = static_cast<unsigned char>(ColorFormat::writeTransition(_palette[from], _palette[to], _transitions[from][to]));
+}
+
+/* ############################################################################################## */
+
+/**
+ * @brief Computes the class of each byte.
+ *
+ * Blocks of 16 bytes are classified with SSE2 comparisons when available,
+ * the remaining bytes one at a time.
+ *
+ * @param bytes The bytes to classify.
+ * @param count The number of bytes.
+ * @param classes The ByteClass of each byte.
+ */
+void HexDump::classify(const unsigned char *bytes, const size_t count, unsigned char *classes) {
+	size_t i = 0;
+
+#ifdef __SSE2__
+	const __m128i zero = _mm_setzero_si128();
+
+	for ( ; i + 16 <= count ; i += 16) {
+		const __m128i block		 = _mm_loadu_si128(reinterpret_cast<const __m128i *>(bytes + i));
+		/* Signed comparisons: bytes from 0x80 are negative, so they are neither printable nor whitespace */
+		const __m128i nul		 = _mm_cmpeq_epi8(block, zero);
+		const __m128i high		 = _mm_cmplt_epi8(block, zero);
+		const __m128i printable	 = _mm_and_si128(_mm_cmpgt_epi8(block, _mm_set1_epi8(0x20)), _mm_cmplt_epi8(block, _mm_set1_epi8(0x7f)));
+		const __m128i whitespace = _mm_or_si128(_mm_cmpeq_epi8(block, _mm_set1_epi8(0x20)),
+												_mm_and_si128(_mm_cmpgt_epi8(block, _mm_set1_epi8(0x08)), _mm_cmplt_epi8(block, _mm_set1_epi8(0x0e))));
+		const __m128i control	 = _mm_andnot_si128(_mm_or_si128(_mm_or_si128(nul, high), _mm_or_si128(printable, whitespace)), _mm_set1_epi8(-1));
+		const __m128i result	 = _mm_or_si128(_mm_or_si128(_mm_and_si128(printable, _mm_set1_epi8(printableByte)),
+															 _mm_and_si128(whitespace, _mm_set1_epi8(whitespaceByte))),
+												_mm_or_si128(_mm_and_si128(control, _mm_set1_epi8(controlByte)),
+															 _mm_and_si128(high, _mm_set1_epi8(highByte))));
+		_mm_storeu_si128(reinterpret_cast<__m128i *>(classes + i), result);
+	}
+#endif
+	for ( ; i < count ; i++) {
+		const unsigned char byte = bytes[i];
+
+		if (!byte)
+			classes[i] = nulByte;
+		else if (byte >= 0x80)
+			classes[i] = highByte;
+		else if (byte > 0x20 and byte < 0x7f)
+			classes[i] = printableByte;
+		else if (byte == 0x20 or (byte >= 0x09 and byte <= 0x0d))
+			classes[i] = whitespaceByte;
+		else
+			classes[i] = controlByte;
+	}
+}
+
+/**
+ * @brief Computes the character column: printable characters and spaces as they are, other bytes as dots.
+ */
+void HexDump::showCharacters(const unsigned char *bytes, const size_t count, char *characters) {
+	size_t i = 0;
+
+#ifdef __SSE2__
+	for ( ; i + 16 <= count ; i += 16) {
+		const __m128i block = _mm_loadu_si128(reinterpret_cast<const __m128i *>(bytes + i));
+		const __m128i shown = _mm_and_si128(_mm_cmpgt_epi8(block, _mm_set1_epi8(0x1f)), _mm_cmplt_epi8(block, _mm_set1_epi8(0x7f)));
+		_mm_storeu_si128(reinterpret_cast<__m128i *>(characters + i),
+						 _mm_or_si128(_mm_and_si128(shown, block), _mm_andnot_si128(shown, _mm_set1_epi8('.'))));
+	}
+#endif
+	for ( ; i < count ; i++)
+		characters[i] = bytes[i] >= 0x20 and bytes[i] < 0x7f ? static_cast<char>(bytes[i]) : '.';
+}
+
+/* ############################################################################################## */
+
+/**
+ * @brief Writes an escape sequence between the colors of two classes.
+ *
+ * Sequences of up to 16 bytes, the usual case, are copied as a fixed-size block: the
+ * bytes beyond the sequence fall within the room reserved for it and are overwritten.
+ */
+static inline char *writeTransition(char *position, const char *transition, const size_t length) {
+	if (length <= 16)
+		std::memcpy(position, transition, 16);
+	else
+		std::memcpy(position, transition, length);
+	return position + length;
+}
+
+/**
+ * @brief Writes the hexadecimal column of a full line, without escape sequences.
+ *
+ * With SSSE3, the digits of the 16 bytes are looked up with byte shuffles, which also
+ * spread them between the spaces; otherwise they are copied from the table of byte digits.
+ *
+ * @return char* The end of the column, without its trailing space.
+ */
+char *HexDump::writeHexColumn(char *position, const unsigned char *bytes) {
+#ifdef __SSSE3__
+	const __m128i digits  = _mm_setr_epi8('0', '1', '2', '3', '4', '5', '6', '7', '8', '9', 'a', 'b', 'c', 'd', 'e', 'f');
+	const __m128i nibble  = _mm_set1_epi8(0x0F);
+	const __m128i block	  = _mm_loadu_si128(reinterpret_cast<const __m128i *>(bytes));
+	const __m128i high	  = _mm_shuffle_epi8(digits, _mm_and_si128(_mm_srli_epi16(block, 4), nibble));
+	const __m128i low	  = _mm_shuffle_epi8(digits, _mm_and_si128(block, nibble));
+	/* Digits of 8 bytes ("h0l0h1l1...") spread to "h0l0 h1l1 ..." over 24 bytes, then the separator of the halves */
+	const __m128i first	  = _mm_setr_epi8(0, 1, -1, 2, 3, -1, 4, 5, -1, 6, 7, -1, 8, 9, -1, 10);
+	const __m128i second  = _mm_setr_epi8(11, -1, 12, 13, -1, 14, 15, -1, -1, -1, -1, -1, -1, -1, -1, -1);
+	const __m128i spaces  = _mm_setr_epi8(0, 0, ' ', 0, 0, ' ', 0, 0, ' ', 0, 0, ' ', 0, 0, ' ', 0);
+	const __m128i trailer = _mm_setr_epi8(0, ' ', 0, 0, ' ', 0, 0, ' ', ' ', ' ', ' ', ' ', ' ', ' ', ' ', ' ');
+	const __m128i halves[2] = {_mm_unpacklo_epi8(high, low), _mm_unpackhi_epi8(high, low)};
+
+	for (size_t half = 0 ; half < 2 ; half++) {
+		_mm_storeu_si128(reinterpret_cast<__m128i *>(position), _mm_or_si128(_mm_shuffle_epi8(halves[half], first), spaces));
+		_mm_storeu_si128(reinterpret_cast<__m128i *>(position + 16), _mm_or_si128(_mm_shuffle_epi8(halves[half], second), trailer));
+		position += half ? 24 : 25;
+	}
+#else
+	for (size_t i = 0 ; i < bytesPerLine ; i++) {
+		std::memcpy(position, _hexDigits + 2 * bytes[i], 2);
+		position[2]	  = ' ';
+		position[3]	  = ' ';
+		position	 += i == bytesPerLine / 2 - 1 ? 4 : 3;
+	}
+#endif
+	return position;
+}
+
+/**
+ * @brief Writes one line of the dump.
+ *
+ * The offset is followed by the hexadecimal column, padded for a short line, and by the
+ * characters between bars, where non-printable bytes are shown as dots.
+ *
+ * The sequence before each byte is written without testing whether its class differs
+ * from the previous one (the sequence is then empty), and the lengths of the sequences are
+ * looked up beforehand: the loops have no unpredictable branch on mixed data, and the
+ * output position only depends on additions.
+ *
+ * @param bytes The bytes of the line.
+ * @param count The number of bytes, at most bytesPerLine.
+ * @param offset The offset of the first byte.
+ * @param line The destination, of at least lineCapacity bytes.
+ * @return size_t The number of bytes written.
+ */
+size_t HexDump::writeLine(const unsigned char *bytes, const size_t count, const size_t offset, char *line) const {
+	static const char digits[] = "0123456789abcdef";
+	unsigned char	  classes[bytesPerLine];
+	char			  characters[bytesPerLine];
+	const char		  *transitions[bytesPerLine];
+	size_t			  lengths[bytesPerLine];
+	size_t			  changes	= 0;
+	char			  *position = line;
+	size_t			  state		= classCount;
+
+	classify(bytes, count, classes);
+	showCharacters(bytes, count, characters);
+	for (size_t i = 0 ; i < count ; i++) {
+		transitions[i] = _transitions[state][classes[i]];
+		lengths[i]	   = _transitionLengths[state][classes[i]];
+		changes		  |= i ? lengths[i] : 0;
+		state		   = classes[i];
+	}
+
+	for (int shift = offset > 0xFFFFFFFFu ? 60 : 28 ; shift >= 0 ; shift -= 4)
+		*position++ = digits[static_cast<uint64_t>(offset) >> shift & 0xF];
+	*position++ = ' ';
+
+	/* A line of a single color, frequent in text and padding, only has an escape at its start */
+	if (!changes and count == bytesPerLine) {
+		*position++ = ' ';
+		position	= writeTransition(position, transitions[0], lengths[0]);
+		position	= writeHexColumn(position, bytes);
+	} else
+		for (size_t i = 0 ; i < count ; i++) {
+			if (i % (bytesPerLine / 2) == 0)
+				*position++ = ' ';
+			position	= writeTransition(position, transitions[i], lengths[i]);
+			std::memcpy(position, _hexDigits + 2 * bytes[i], 2);
+			position[2] = ' ';
+			position   += 3;
+		}
+	if (_palette[state]) {
+		std::memcpy(position, "\033[0m", 4);
+		position += 4;
+	}
+	for (size_t i = count ; i < bytesPerLine ; i++) {
+		if (i % (bytesPerLine / 2) == 0)
+			*position++ = ' ';
+		std::memcpy(position, "   ", 3);
+		position += 3;
+	}
+	*position++ = ' ';
+	*position++ = '|';
+
+	if (!changes and count) {
+		position = writeTransition(position, transitions[0], lengths[0]);
+		std::memcpy(position, characters, count);
+		position += count;
+	} else
+		for (size_t i = 0 ; i < count ; i++) {
+			position	= writeTransition(position, transitions[i], lengths[i]);
+			*position++ = characters[i];
+		}
+	if (_palette[state]) {
+		std::memcpy(position, "\033[0m", 4);
+		position += 4;
+	}
+	*position++ = '|';
+	*position++ = '\n';
+	return static_cast<size_t>(position - line);
+}
+
+void HexDump::write(const void *data, const size_t length, BufferedWriter &output, const size_t offset) const {
+	const unsigned char *bytes = static_cast<const unsigned char *>(data);
+
+	for (size_t start = 0 ; start < length ; start += bytesPerLine) {
+		const size_t count = length - start < static_cast<size_t>(bytesPerLine) ? length - start : static_cast<size_t>(bytesPerLine);
+		output.advance(writeLine(bytes + start, count, offset + start, output.acquire(lineCapacity)));
+	}
+}
+
+/* ############################################################################################## */
+
+static const HexDump &defaultDump(void) {
+	static const HexDump dump;
+	return dump;
+}
+
+void hexdump(const void *data, const size_t length, BufferedWriter &output) { defaultDump().write(data, length, output); }
+
+void hexdump(const void *data, const size_t length, std::ostream &stream) {
+	BufferedWriter output(stream);
+
+	defaultDump().write(data, length, output);
+}
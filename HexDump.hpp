@@ -0,0 +1,143 @@
+#pragma once
+
+/* ############################################################################################## */
+
+/**
+ * @file HexDump.hpp
+ * @brief Declaration of the HexDump class, which writes binary data as colored hexadecimal.
+ *
+ * Each line shows an offset, 16 bytes in hexadecimal and their printable characters,
+ * colored by byte class (NUL, printable, whitespace, control, high bit):
+ * ```
+ * 00000000  48 65 6c 6c 6f 0a 00 00  ff fe 01 02 41 42 43 44  |Hello.......ABCD|
+ * ```
+ * The bytes are classified 16 at a time (with SSE2 when available) and an escape sequence
+ * is only written where the class changes between adjacent bytes.
+ *
+ * @author aheitz
+ * @date Created: 2026-10-17
+ * @date Last Modified: 2026-10-17
+ */
+
+/* ############################################################################################## */
+
+/*
+ * This file is part of the ColorFormat library.
+ *
+ * Copyright (C) 2025 aheitz <alexy.pa.heitz@gmail.com>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+/* ############################################################################################## */
+
+#include "BufferedWriter.hpp"
+#include "ColorFormat.hpp"
+
+#include <ostream>
+#include <string>
+
+/* ############################################################################################## */
+
+/**
+ * @brief Colored hexadecimal dump, with a color per byte class.
+ */
+class HexDump {
+	public:
+		enum ByteClass {
+			nulByte,		/**< 0x00 */
+			printableByte,	/**< 0x21 to 0x7e */
+			whitespaceByte,	/**< Space, \\t, \\n, \\v, \\f and \\r */
+			controlByte,	/**< Other bytes below 0x80 */
+			highByte,		/**< 0x80 to 0xff */
+			classCount
+		};
+
+		enum {
+			bytesPerLine = 16,
+			/** Longest line written by writeLine(): offset, hexadecimal and character columns with an escape per byte */
+			lineCapacity = 16 + 2 + bytesPerLine * (ColorFormat::transitionCapacity + 3) + 1 + 4 + 2
+						 + bytesPerLine * (ColorFormat::transitionCapacity + 1) + 4 + 2
+		};
+
+		/**
+		 * @brief Creates a dump with the default colors: gray NUL bytes, cyan printable characters,
+		 * green whitespace, magenta control characters and yellow high bytes.
+		 */
+		HexDump(void);
+
+		/** @name Colors of the byte classes */
+		/** @{ */
+		HexDump &color(ByteClass byteClass, ColorFormat::Attributes attributes);
+		ColorFormat::Attributes color(ByteClass byteClass) const;
+		/** @} */
+
+		/**
+		 * @brief Writes the dump of a block.
+		 * @param offset The offset shown for the first byte.
+		 * @throws std::length_error if the writer holds less than lineCapacity bytes.
+		 */
+		void write(const void *data, size_t length, BufferedWriter &output, size_t offset = 0) const;
+
+		/**
+		 * @brief Appends the dump of a block to any string type.
+		 */
+		template <typename String>
+		String &append(String &output, const void *data, size_t length, size_t offset = 0) const;
+
+		/**
+		 * @brief Writes one line of at most bytesPerLine bytes.
+		 * @param line The destination, of at least lineCapacity bytes.
+		 * @return The number of bytes written.
+		 */
+		size_t writeLine(const unsigned char *bytes, size_t count, size_t offset, char *line) const;
+
+		/**
+		 * @brief Computes the ByteClass of each byte.
+		 */
+		static void classify(const unsigned char *bytes, size_t count, unsigned char *classes);
+	private:
+		static void showCharacters(const unsigned char *bytes, size_t count, char *characters);
+		static char *writeHexColumn(char *position, const unsigned char *bytes);
+		/** Colors of the classes, then no color (the state at the start of a line) */
+		ColorFormat::Attributes	_palette[classCount + 1];
+		unsigned char			_transitionLengths[classCount + 1][classCount];
+		char					_transitions[classCount + 1][classCount][ColorFormat::transitionCapacity];
+
+		static const char _hexDigits[513];
+
+		void prepareTransitions(void);
+};
+
+/* ############################################################################################## */
+
+/** @name Dumps with the default colors */
+/** @{ */
+void hexdump(const void *data, size_t length, BufferedWriter &output);
+void hexdump(const void *data, size_t length, std::ostream &stream);
+/** @} */
+
+/* ############################################################################################## */
+
+template <typename String>
+String &HexDump::append(String &output, const void *data, const size_t length, const size_t offset) const {
+	const unsigned char *bytes = static_cast<const unsigned char *>(data);
+	char				line[lineCapacity];
+
+	for (size_t start = 0 ; start < length ; start += bytesPerLine) {
+		const size_t count = length - start < static_cast<size_t>(bytesPerLine) ? length - start : static_cast<size_t>(bytesPerLine);
+		output.append(line, writeLine(bytes + start, count, offset + start, line));
+	}
+	return output;
+}
@@ -0,0 +1,158 @@
+#pragma once
+
+/* ############################################################################################## */
+
+/**
+ * @file InlineString.hpp
+ * @brief Declaration of the InlineString class, a string stored in place up to a fixed capacity.
+ *
+ * Short formatted values (a log level, a colored number) rarely exceed a few dozen bytes,
+ * which is more than the small string optimization of std::string holds. An InlineString
+ * keeps them in its own buffer and only allocates when the text does not fit:
+ * ```
+ * const InlineString<> level = ColorFormat::inlineString("WARN", "yellow", "bold");
+ * std::cout << level << std::endl;
+ * ```
+ *
+ * @author aheitz
+ * @date Created: 2026-10-17
+ * @date Last Modified: 2026-10-17
+ */
+
+/* ############################################################################################## */
+
+/*
+ * This file is part of the ColorFormat library.
+ *
+ * Copyright (C) 2025 aheitz <alexy.pa.heitz@gmail.com>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+/* ############################################################################################## */
+
+#include <cstddef>
+#include <cstring>
+#include <ostream>
+#include <string>
+#if __cplusplus >= 201703L
+# include <string_view>
+#endif
+
+/* ############################################################################################## */
+
+/**
+ * @brief Text stored in place up to `Capacity` bytes, on the heap beyond.
+ *
+ * It provides the subset of std::string used by the ColorFormat append functions
+ * (`append()`, `reserve()`, `size()`), so any of them can write into it.
+ *
+ * @tparam Capacity The number of bytes stored without allocating.
+ */
+template <size_t Capacity = 48>
+class InlineString {
+	private:
+		char	_buffer[Capacity];
+		char	*_heap;			/**< Storage once the text outgrew the buffer, NULL before */
+		size_t	_heapCapacity;
+		size_t	_length;
+
+		char *storage(void) { return _heap ? _heap : _buffer; }
+	public:
+		InlineString(void) : _heap(NULL), _heapCapacity(0), _length(0) {}
+
+		InlineString(const InlineString &source) : _heap(NULL), _heapCapacity(0), _length(0) {
+			append(source.data(), source.size());
+		}
+
+		InlineString &operator=(const InlineString &source) {
+			if (this != &source) {
+				_length = 0;
+				append(source.data(), source.size());
+			}
+			return *this;
+		}
+
+#if __cplusplus >= 201103L
+		InlineString(InlineString &&source) noexcept : _heap(source._heap), _heapCapacity(source._heapCapacity), _length(source._length) {
+			if (!_heap)
+				std::memcpy(_buffer, source._buffer, _length);
+			source._heap		 = NULL;
+			source._heapCapacity = 0;
+			source._length		 = 0;
+		}
+
+		/** Takes the heap storage of `source`, or copies its inline text into the current storage. */
+		InlineString &operator=(InlineString &&source) noexcept {
+			if (this != &source) {
+				if (source._heap) {
+					delete[] _heap;
+					_heap				 = source._heap;
+					_heapCapacity		 = source._heapCapacity;
+					source._heap		 = NULL;
+					source._heapCapacity = 0;
+				} else
+					std::memcpy(storage(), source._buffer, source._length);
+				_length		   = source._length;
+				source._length = 0;
+			}
+			return *this;
+		}
+#endif
+
+		~InlineString(void) { delete[] _heap; }
+
+		/**
+		 * @brief Makes room for a total of `capacity` bytes, moving the text to the heap if needed.
+		 */
+		void reserve(const size_t capacity) {
+			if (capacity <= (_heap ? _heapCapacity : Capacity))
+				return;
+
+			size_t grown = _heap ? _heapCapacity * 2 : Capacity * 2;
+			if (grown < capacity)
+				grown = capacity;
+
+			char *heap = new char[grown];
+			std::memcpy(heap, data(), _length);
+			delete[] _heap;
+			_heap		  = heap;
+			_heapCapacity = grown;
+		}
+
+		void append(const char *text, const size_t length) {
+			reserve(_length + length);
+			std::memcpy(storage() + _length, text, length);
+			_length += length;
+		}
+
+		void clear(void) { _length = 0; }
+
+		const char *data(void) const { return _heap ? _heap : _buffer; }
+		size_t size(void) const { return _length; }
+		bool empty(void) const { return !_length; }
+
+		/** Tells whether the text still fits in the inline buffer. */
+		bool isInline(void) const { return !_heap; }
+
+		std::string str(void) const { return std::string(data(), _length); }
+
+#if __cplusplus >= 201703L
+		operator std::string_view(void) const { return std::string_view(data(), _length); }
+#endif
+
+		friend std::ostream &operator<<(std::ostream &stream, const InlineString &string) {
+			return stream.write(string.data(), static_cast<std::streamsize>(string.size()));
+		}
+};
@@ -0,0 +1,432 @@
+#include "JsonColorizer.hpp"
+
+/* ############################################################################################## */
+
+/**
+ * @file JsonColorizer.cpp
+ * @brief Implementation of the JsonColorizer class.
+ *
+ * This file contains the tokenizer, which keeps its whole state in the colorizer so that
+ * chunks can be split anywhere, and the SIMD scans of strings, whitespace runs and scalars.
+ *
+ * @author aheitz
+ * @date Created: 2026-10-17
+ * @date Last Modified: 2026-10-17
+ */
+
+/* ############################################################################################## */
+
+/*
+ * This file is part of the ColorFormat library.
+ *
+ * Copyright (C) 2025 aheitz <alexy.pa.heitz@gmail.com>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+/* ############################################################################################## */
+
+#include <cstring>
+#ifdef __SSE2__
+# include <emmintrin.h>
+#endif
+#ifdef __SSSE3__
+# include <tmmintrin.h>
+#endif
+
+/* ############################################################################################## */
+
+/**
+ * @brief Tells whether a byte is JSON whitespace.
+ */
+static inline bool isWhitespace(const char character) {
+	return character == ' ' or character == '\n' or character == '\r' or character == '\t';
+}
+
+/**
+ * @brief Tells whether a byte ends a number or a literal.
+ */
+static inline bool endsScalar(const char character) {
+	switch (character) {
+		case ' ': case '\n': case '\r': case '\t':
+		case '{': case '}': case '[': case ']': case ':': case ',': case '"':
+			return true;
+		default:
+			return false;
+	}
+}
+
+#ifdef __SSE2__
+/**
+ * @brief Returns the index of the lowest bit set in a non-zero mask.
+ */
+static inline unsigned int lowestBit(unsigned int mask) {
+# if defined(__GNUC__)
+	return static_cast<unsigned int>(__builtin_ctz(mask));
+# else
+	unsigned int index = 0;
+
+	while (!(mask & 1)) {
+		mask >>= 1;
+		index++;
+	}
+	return index;
+# endif
+}
+#endif
+
+/**
+ * @brief Finds the first quote or backslash of a block, which is where a string can end.
+ *
+ * The bytes are compared 16 at a time with SSE2 when available.
+ *
+ * @return The index found, or length if there is none.
+ */
+static size_t findQuoteOrBackslash(const char *data, const size_t length) {
+	size_t i = 0;
+
+#ifdef __SSE2__
+	const __m128i quote		= _mm_set1_epi8('"');
+	const __m128i backslash = _mm_set1_epi8('\\');
+
+	for ( ; i + 16 <= length ; i += 16) {
+		const __m128i	   block = _mm_loadu_si128(reinterpret_cast<const __m128i *>(data + i));
+		const unsigned int mask	 = static_cast<unsigned int>(_mm_movemask_epi8(_mm_or_si128(_mm_cmpeq_epi8(block, quote),
+																								 _mm_cmpeq_epi8(block, backslash))));
+		if (mask)
+			return i + lowestBit(mask);
+	}
+#endif
+	for ( ; i < length ; i++)
+		if (data[i] == '"' or data[i] == '\\')
+			return i;
+	return length;
+}
+
+#ifdef __SSE2__
+/**
+ * @brief Classifies 16 bytes at once, setting bit i of a mask when byte i is whitespace,
+ * or a structural character (`{}[]:,` and the quote).
+ *
+ * With SSSE3, the classes of each byte are looked up by its low and its high nibble with
+ * two byte shuffles, then and'ed; otherwise the bytes are compared with each character.
+ */
+static inline void classifyBlock(const char *data, unsigned int &whitespace, unsigned int &structural) {
+	const __m128i block = _mm_loadu_si128(reinterpret_cast<const __m128i *>(data));
+# ifdef __SSSE3__
+	/* Classes: 1 ',', 2 ':', 4 brackets and braces, 8 space, 16 tab, line feed and carriage return, 32 quote */
+	const __m128i lowNibbles  = _mm_setr_epi8(8, 0, 32, 0, 0, 0, 0, 0, 0, 16, 18, 4, 1, 20, 0, 0);
+	const __m128i highNibbles = _mm_setr_epi8(16, 0, 41, 2, 0, 4, 0, 4, 0, 0, 0, 0, 0, 0, 0, 0);
+	const __m128i nibble	  = _mm_set1_epi8(0x0F);
+	const __m128i classes	  = _mm_and_si128(_mm_shuffle_epi8(lowNibbles, _mm_and_si128(block, nibble)),
+											  _mm_shuffle_epi8(highNibbles, _mm_and_si128(_mm_srli_epi16(block, 4), nibble)));
+	const __m128i zero		  = _mm_setzero_si128();
+
+	whitespace = static_cast<unsigned int>(_mm_movemask_epi8(_mm_cmpeq_epi8(_mm_and_si128(classes, _mm_set1_epi8(24)), zero))) ^ 0xffff;
+	structural = static_cast<unsigned int>(_mm_movemask_epi8(_mm_cmpeq_epi8(_mm_and_si128(classes, _mm_set1_epi8(39)), zero))) ^ 0xffff;
+# else
+	const __m128i spaces	= _mm_or_si128(_mm_or_si128(_mm_cmpeq_epi8(block, _mm_set1_epi8(' ')), _mm_cmpeq_epi8(block, _mm_set1_epi8('\n'))),
+										   _mm_or_si128(_mm_cmpeq_epi8(block, _mm_set1_epi8('\r')), _mm_cmpeq_epi8(block, _mm_set1_epi8('\t'))));
+	const __m128i brackets	= _mm_or_si128(_mm_or_si128(_mm_cmpeq_epi8(block, _mm_set1_epi8('{')), _mm_cmpeq_epi8(block, _mm_set1_epi8('}'))),
+										   _mm_or_si128(_mm_cmpeq_epi8(block, _mm_set1_epi8('[')), _mm_cmpeq_epi8(block, _mm_set1_epi8(']'))));
+	const __m128i separators = _mm_or_si128(_mm_or_si128(_mm_cmpeq_epi8(block, _mm_set1_epi8(':')), _mm_cmpeq_epi8(block, _mm_set1_epi8(','))),
+											_mm_cmpeq_epi8(block, _mm_set1_epi8('"')));
+
+	whitespace = static_cast<unsigned int>(_mm_movemask_epi8(spaces));
+	structural = static_cast<unsigned int>(_mm_movemask_epi8(_mm_or_si128(brackets, separators)));
+# endif
+}
+#endif
+
+/**
+ * @brief Finds the first byte of a block that is not whitespace.
+ *
+ * @return The index found, or length if there is none.
+ */
+static size_t findNonWhitespace(const char *data, const size_t length) {
+	size_t i = 0;
+
+#ifdef __SSE2__
+	for ( ; i + 16 <= length ; i += 16) {
+		unsigned int whitespace;
+		unsigned int structural;
+
+		classifyBlock(data + i, whitespace, structural);
+		if (whitespace != 0xffff)
+			return i + lowestBit(whitespace ^ 0xffff);
+	}
+#endif
+	for ( ; i < length ; i++)
+		if (!isWhitespace(data[i]))
+			return i;
+	return length;
+}
+
+/**
+ * @brief Finds the end of a number or a literal: the first whitespace or structural byte of a block.
+ *
+ * @return The index found, or length if there is none.
+ */
+static size_t findScalarEnd(const char *data, const size_t length) {
+	size_t i = 0;
+
+#ifdef __SSE2__
+	for ( ; i + 16 <= length ; i += 16) {
+		unsigned int whitespace;
+		unsigned int structural;
+
+		classifyBlock(data + i, whitespace, structural);
+		if (whitespace | structural)
+			return i + lowestBit(whitespace | structural);
+	}
+#endif
+	for ( ; i < length ; i++)
+		if (endsScalar(data[i]))
+			return i;
+	return length;
+}
+
+/* ############################################################################################## */
+
+JsonColorizer::JsonColorizer(BufferedWriter &output) : _output(output), _indentWidth(0), _current(noToken), _started(false) {
+	_palette[keyToken]		   = ColorFormat::blue | ColorFormat::bold;
+	_palette[stringToken]	   = ColorFormat::green;
+	_palette[numberToken]	   = ColorFormat::cyan;
+	_palette[literalToken]	   = ColorFormat::yellow;
+	_palette[punctuationToken] = ColorFormat::bold;
+	_palette[noToken]		   = 0;
+	prepareTransitions();
+	finish();
+}
+
+JsonColorizer &JsonColorizer::color(const Token token, const ColorFormat::Attributes attributes) {
+	_palette[token] = attributes;
+	prepareTransitions();
+	return *this;
+}
+
+ColorFormat::Attributes JsonColorizer::color(const Token token) const { return _palette[token]; }
+
+JsonColorizer &JsonColorizer::indent(const unsigned int width) {
+	_indentWidth = width;
+	return *this;
+}
+
+/**
+ * @brief Precomputes the escape sequences between the colors of every pair of tokens.
+ */
+void JsonColorizer::prepareTransitions(void) {
+	for (size_t from = 0 ; from <= tokenCount ; from++)
+		for (size_t to = 0 ; to <= tokenCount ; to++)
+			_transitionLengths[from][to] = static_cast<unsigned char>(ColorFormat::writeTransition(_palette[from], _palette[to], _transitions[from][to]));
+}
+
+/* ############################################################################################## */
+
+/**
+ * @brief Applies the color of a token, writing only what changes from the current one.
+ *
+ * Most transitions are a few bytes long: they are copied as a fixed block of 16 bytes,
+ * which avoids a call to memcpy() for each token.
+ */
+void JsonColorizer::switchTo(const size_t token) {
+	if (token != _current) {
+		const size_t length	  = _transitionLengths[_current][token];
+		char *const	 position = _output.acquire(ColorFormat::transitionCapacity);
+
+		if (length <= 16)
+			std::memcpy(position, _transitions[_current][token], 16);
+		else
+			std::memcpy(position, _transitions[_current][token], length);
+		_output.advance(length);
+		_current = token;
+	}
+}
+
+/**
+ * @brief Starts a new line indented for the given depth.
+ */
+void JsonColorizer::newLine(size_t depth) {
+	static const char spaces[] = "                                                                ";
+
+	_output.append('\n');
+	for (size_t remaining = depth * _indentWidth ; remaining ; ) {
+		const size_t length = remaining < sizeof(spaces) - 1 ? remaining : sizeof(spaces) - 1;
+
+		_output.append(spaces, length);
+		remaining -= length;
+	}
+}
+
+bool JsonColorizer::inObject(void) const {
+	return _depth and _depth <= static_cast<size_t>(maximumDepth) and (_objects[(_depth - 1) / 64] >> ((_depth - 1) % 64) & 1);
+}
+
+/**
+ * @brief Writes a structural character and updates the nesting.
+ */
+void JsonColorizer::punctuation(const char character) {
+	switch (character) {
+		case '{':
+		case '[':
+			if (_depth < static_cast<size_t>(maximumDepth)) {
+				const uint64_t bit = static_cast<uint64_t>(1) << (_depth % 64);
+
+				_objects[_depth / 64] = character == '{' ? _objects[_depth / 64] | bit : _objects[_depth / 64] & ~bit;
+			}
+			_depth++;
+			_expectKey	 = character == '{';
+			_pendingOpen = _indentWidth != 0;
+			break;
+		case '}':
+		case ']':
+			if (_depth)
+				_depth--;
+			_expectKey = false;
+			break;
+		case ':':
+			_expectKey = false;
+			break;
+		default:
+			_expectKey = inObject();
+			break;
+	}
+	switchTo(punctuationToken);
+	_output.append(character);
+	if (_indentWidth) {
+		if (character == ',')
+			newLine(_depth);
+		else if (character == ':')
+			_output.append(' ');
+	}
+}
+
+/* ############################################################################################## */
+
+/**
+ * @brief Colors the next chunk of the document.
+ *
+ * The bytes of strings and whitespace runs are copied in blocks; an escape sequence is
+ * only written where the kind of token changes.
+ *
+ * @param data The chunk, which can end anywhere in the document.
+ * @param length The size of the chunk.
+ */
+void JsonColorizer::write(const char *data, const size_t length) {
+	size_t i = 0;
+
+	while (i < length) {
+		if (_inString) {
+			if (_escaped) {
+				_output.append(data[i++]);
+				_escaped = false;
+				continue;
+			}
+			const size_t end = i + findQuoteOrBackslash(data + i, length - i);
+
+			_output.append(data + i, end - i);
+			if ((i = end) == length)
+				break;
+			_output.append(data[i]);
+			if (data[i++] == '"')
+				_inString = false;
+			else
+				_escaped = true;
+			continue;
+		}
+		if (_scalar != noToken) {
+			const size_t end = i + findScalarEnd(data + i, length - i);
+
+			_output.append(data + i, end - i);
+			if ((i = end) < length)
+				_scalar = noToken;
+			continue;
+		}
+
+		const char character = data[i];
+
+		if (isWhitespace(character)) {
+			const size_t end = i + findNonWhitespace(data + i, length - i);
+
+			if (!_indentWidth)
+				_output.append(data + i, end - i);
+			i = end;
+			continue;
+		}
+		if (_indentWidth) {
+			const bool closing = character == '}' or character == ']';
+
+			if (_pendingOpen) {
+				_pendingOpen = false;
+				if (!closing)
+					newLine(_depth);
+			} else if (closing)
+				newLine(_depth ? _depth - 1 : 0);
+			else if (!_depth and _started and character != ',' and character != ':')
+				_output.append('\n');
+		}
+		_started = true;
+		switch (character) {
+			case '"':
+				switchTo(_expectKey ? keyToken : stringToken);
+				_output.append(character);
+				_inString = true;
+				i++;
+				break;
+			case '{': case '}': case '[': case ']': case ':': case ',':
+				punctuation(character);
+				i++;
+				break;
+			default:
+				/* The scalar is copied from its first byte on the next iteration */
+				_scalar = character == '-' or (character >= '0' and character <= '9') ? numberToken : literalToken;
+				switchTo(_scalar);
+				break;
+		}
+	}
+}
+
+/**
+ * @brief Ends the document.
+ *
+ * The terminal is reset and a re-indented document gets its final newline.
+ */
+void JsonColorizer::finish(void) {
+	switchTo(noToken);
+	if (_indentWidth and _started)
+		_output.append('\n');
+	_scalar		 = noToken;
+	_inString	 = false;
+	_escaped	 = false;
+	_expectKey	 = false;
+	_pendingOpen = false;
+	_started	 = false;
+	_depth		 = 0;
+	std::memset(_objects, 0, sizeof(_objects));
+}
+
+/* ############################################################################################## */
+
+void JsonColorizer::colorize(std::istream &input, std::ostream &output, const unsigned int indentWidth) {
+	BufferedWriter writer(output);
+	JsonColorizer  colorizer(writer);
+	char		   chunk[1 << 14];
+
+	colorizer.indent(indentWidth);
+	do {
+		input.read(chunk, sizeof(chunk));
+		colorizer.write(chunk, static_cast<size_t>(input.gcount()));
+	} while (input);
+	colorizer.finish();
+}
@@ -0,0 +1,128 @@
+#pragma once
+
+/* ############################################################################################## */
+
+/**
+ * @file JsonColorizer.hpp
+ * @brief Declaration of the JsonColorizer class, which colors JSON documents as they stream.
+ *
+ * The document can be given in chunks of any size, split anywhere (even inside a string
+ * or an escape sequence); only a fixed state is kept between them:
+ * ```
+ * BufferedWriter output(std::cout);
+ * JsonColorizer  colorizer(output);
+ * colorizer.indent(2);
+ * while (receive(chunk))
+ *     colorizer.write(chunk.data(), chunk.size());
+ * colorizer.finish();
+ * ```
+ * Strings, whitespace runs, numbers and literals are crossed 16 bytes at a time: strings
+ * with SSE2 masks of quotes and backslashes, the others with masks of the whitespace and
+ * structural bytes (`{}[]:,"`), looked up by nibble with SSSE3.
+ *
+ * @author aheitz
+ * @date Created: 2026-10-17
+ * @date Last Modified: 2026-10-17
+ */
+
+/* ############################################################################################## */
+
+/*
+ * This file is part of the ColorFormat library.
+ *
+ * Copyright (C) 2025 aheitz <alexy.pa.heitz@gmail.com>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+/* ############################################################################################## */
+
+#include "BufferedWriter.hpp"
+#include "ColorFormat.hpp"
+
+#include <istream>
+#include <ostream>
+
+/* ############################################################################################## */
+
+/**
+ * @brief Streaming JSON colorizer, with optional re-indentation.
+ *
+ * The input is not validated: malformed documents are colored as well as possible.
+ */
+class JsonColorizer {
+	public:
+		enum Token { keyToken, stringToken, numberToken, literalToken, punctuationToken, tokenCount };
+
+		enum {
+			/** Deepest nesting whose containers are told apart; deeper keys are colored as strings */
+			maximumDepth = 1024
+		};
+
+		/**
+		 * @brief Creates a colorizer with the default colors: bold blue keys, green strings,
+		 * cyan numbers, yellow literals and bold punctuation.
+		 */
+		explicit JsonColorizer(BufferedWriter &output);
+
+		/** @name Settings */
+		/** @{ */
+		JsonColorizer &color(Token token, ColorFormat::Attributes attributes);
+		ColorFormat::Attributes color(Token token) const;
+		/**
+		 * @brief Re-indents the document with `width` spaces per level; 0 keeps its whitespace.
+		 */
+		JsonColorizer &indent(unsigned int width);
+		/** @} */
+
+		/** Colors the next chunk of the document. */
+		void write(const char *data, size_t length);
+
+		/** Ends the document, resetting the terminal. The colorizer can then start another one. */
+		void finish(void);
+
+		/**
+		 * @brief Colors a whole stream, read in chunks.
+		 * @param indentWidth Spaces per level, 0 to keep the whitespace of the document.
+		 */
+		static void colorize(std::istream &input, std::ostream &output, unsigned int indentWidth = 0);
+	private:
+		enum { noToken = tokenCount };
+
+		BufferedWriter			&_output;
+		ColorFormat::Attributes	_palette[tokenCount + 1];
+		unsigned char			_transitionLengths[tokenCount + 1][tokenCount + 1];
+		char					_transitions[tokenCount + 1][tokenCount + 1][ColorFormat::transitionCapacity];
+		unsigned int			_indentWidth;
+
+		/* State kept between chunks */
+		size_t			_current;		/**< Token whose color is applied */
+		size_t			_scalar;		/**< Number or literal being written, noToken outside */
+		bool			_inString;
+		bool			_escaped;		/**< The previous string byte was a backslash */
+		bool			_expectKey;
+		bool			_pendingOpen;	/**< A container was opened and its first line is not written yet */
+		bool			_started;		/**< Something was written since the last finish() */
+		size_t			_depth;
+		uint64_t		_objects[maximumDepth / 64];	/**< Bit set for each nesting level that is an object */
+
+		void prepareTransitions(void);
+		void switchTo(size_t token);
+		void newLine(size_t depth);
+		bool inObject(void) const;
+		void punctuation(char character);
+
+		JsonColorizer(const JsonColorizer &source);
+		JsonColorizer &operator=(const JsonColorizer &source);
+};
@@ -0,0 +1,459 @@
+#include "LogfmtColorizer.hpp"
+
+/* ############################################################################################## */
+
+/**
+ * @file LogfmtColorizer.cpp
+ * @brief Implementation of the LogfmtColorizer class.
+ *
+ * This file contains the single-pass tokenizer of logfmt lines and the styling of levels
+ * and numbers.
+ *
+ * @author aheitz
+ * @date Created: 2026-10-17
+ * @date Last Modified: 2026-10-17
+ */
+
+/* ############################################################################################## */
+
+/*
+ * This file is part of the ColorFormat library.
+ *
+ * Copyright (C) 2025 aheitz <alexy.pa.heitz@gmail.com>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+/* ############################################################################################## */
+
+#include <cstring>
+#ifdef __SSE2__
+# include <emmintrin.h>
+#endif
+
+/* ############################################################################################## */
+
+/** Theme names of the levels, in the order of LogfmtColorizer::Level */
+static const char *const levelNames[LogfmtColorizer::levelCount] = {
+	"level.trace", "level.debug", "level.info", "level.warn", "level.error", "level.fatal"
+};
+
+/** Colors of the levels the theme leaves undefined */
+static const ColorFormat::Attributes defaultLevels[LogfmtColorizer::levelCount] = {
+	ColorFormat::brightBlack,
+	ColorFormat::blue,
+	ColorFormat::green,
+	ColorFormat::yellow,
+	static_cast<ColorFormat::Attributes>(ColorFormat::red) | ColorFormat::bold,
+	static_cast<ColorFormat::Attributes>(ColorFormat::red) | ColorFormat::bold | ColorFormat::inverse
+};
+
+static inline bool isBlank(const char character) { return character == ' ' or character == '\t'; }
+
+/**
+ * @brief Compares a text with a lowercase word, ignoring the case of the text.
+ */
+static bool equalsWord(const char *text, const size_t length, const char *word) {
+	size_t i = 0;
+
+	for ( ; i < length and word[i] ; i++)
+		if ((text[i] | 0x20) != word[i])
+			return false;
+	return i == length and !word[i];
+}
+
+/* ############################################################################################## */
+
+LogfmtColorizer::LogfmtColorizer(BufferedWriter &output)
+	: _output(output), _current(noToken), _currentAttributes(0), _run(nullptr), _limit(nullptr) {
+	_palette[keyToken]	  = ColorFormat::blue;
+	_palette[valueToken]  = 0;
+	_palette[stringToken] = ColorFormat::green;
+	_palette[noToken]	  = 0;
+	prepareTransitions();
+	for (size_t level = 0 ; level < levelCount ; level++)
+		_levels[level] = ThemeRegistry::handle(levelNames[level]);
+	for (size_t i = 0 ; i < cacheSize ; i++)
+		_cache[i].valid = false;
+}
+
+LogfmtColorizer &LogfmtColorizer::color(const Token token, const ColorFormat::Attributes attributes) {
+	_palette[token] = attributes;
+	prepareTransitions();
+	return *this;
+}
+
+ColorFormat::Attributes LogfmtColorizer::color(const Token token) const { return _palette[token]; }
+
+LogfmtColorizer &LogfmtColorizer::range(const std::string &key, const unsigned int minimum, const unsigned int maximum) {
+	for (size_t i = 0 ; i < _ranges.size() ; i++)
+		if (_ranges[i].key == key) {
+			_ranges[i].minimum = minimum;
+			_ranges[i].maximum = maximum;
+			return *this;
+		}
+	_ranges.push_back(Range{key, minimum, maximum});
+	return *this;
+}
+
+/**
+ * @brief Precomputes the escape sequences between the colors of every pair of tokens.
+ */
+void LogfmtColorizer::prepareTransitions(void) {
+	for (size_t from = 0 ; from <= tokenCount ; from++)
+		for (size_t to = 0 ; to <= tokenCount ; to++)
+			_transitionLengths[from][to] = static_cast<unsigned char>(ColorFormat::writeTransition(_palette[from], _palette[to], _transitions[from][to]));
+}
+
+/* ############################################################################################## */
+
+/**
+ * @brief Applies the color of a token, writing only what changes from the current one.
+ *
+ * Transitions between tokens are precomputed and copied as a fixed block of 16 bytes when
+ * they fit; transitions from a level or a gradient color are computed on the spot.
+ */
+void LogfmtColorizer::switchTo(const size_t token) {
+	if (token == _current)
+		return;
+	if (_current == otherToken) {
+		switchToAttributes(_palette[token]);
+		_current = token;
+		return;
+	}
+
+	const size_t length	  = _transitionLengths[_current][token];
+	char *const	 position = _output.acquire(ColorFormat::transitionCapacity);
+
+	if (length <= 16)
+		std::memcpy(position, _transitions[_current][token], 16);
+	else
+		std::memcpy(position, _transitions[_current][token], length);
+	_output.advance(length);
+	_current		   = token;
+	_currentAttributes = _palette[token];
+}
+
+/**
+ * @brief Applies any attributes, for levels and gradients.
+ *
+ * Their transitions are kept in a small direct-mapped cache, as a log only uses a few of them.
+ */
+void LogfmtColorizer::switchToAttributes(const ColorFormat::Attributes attributes) {
+	if (attributes != _currentAttributes) {
+		/* Multiplicative hash: the top 6 bits index the 64 entries */
+		CachedTransition &cached = _cache[(_currentAttributes * 31 + attributes) * 0x9E3779B97F4A7C15ull >> 58];
+
+		if (cached.from != _currentAttributes or cached.to != attributes or !cached.valid) {
+			cached.from	  = _currentAttributes;
+			cached.to	  = attributes;
+			cached.valid  = true;
+			cached.length = static_cast<unsigned char>(ColorFormat::writeTransition(_currentAttributes, attributes, cached.bytes));
+		}
+		char *const position = _output.acquire(ColorFormat::transitionCapacity);
+
+		if (cached.length <= 16)
+			std::memcpy(position, cached.bytes, 16);
+		else
+			std::memcpy(position, cached.bytes, cached.length);
+		_output.advance(cached.length);
+	}
+	_current		   = otherToken;
+	_currentAttributes = attributes;
+}
+
+/**
+ * @brief Finds the severity of a level value.
+ *
+ * @return The Level, or levelCount if the value is not a known severity.
+ */
+static size_t findLevel(const char *value, const size_t length) {
+	if (!length)
+		return LogfmtColorizer::levelCount;
+	switch (value[0] | 0x20) {
+		case 'i':
+			return equalsWord(value, length, "info") or equalsWord(value, length, "information") ? LogfmtColorizer::infoLevel : LogfmtColorizer::levelCount;
+		case 'n':
+			return equalsWord(value, length, "notice") ? LogfmtColorizer::infoLevel : LogfmtColorizer::levelCount;
+		case 'w':
+			return equalsWord(value, length, "warn") or equalsWord(value, length, "warning") ? LogfmtColorizer::warningLevel : LogfmtColorizer::levelCount;
+		case 'e':
+			return equalsWord(value, length, "error") or equalsWord(value, length, "err") ? LogfmtColorizer::errorLevel : LogfmtColorizer::levelCount;
+		case 'd':
+			return equalsWord(value, length, "debug") or equalsWord(value, length, "dbug") ? LogfmtColorizer::debugLevel : LogfmtColorizer::levelCount;
+		case 't':
+			return equalsWord(value, length, "trace") ? LogfmtColorizer::traceLevel : LogfmtColorizer::levelCount;
+		case 'f':
+			return equalsWord(value, length, "fatal") ? LogfmtColorizer::fatalLevel : LogfmtColorizer::levelCount;
+		case 'c':
+			return equalsWord(value, length, "crit") or equalsWord(value, length, "critical") ? LogfmtColorizer::fatalLevel : LogfmtColorizer::levelCount;
+		case 'p':
+			return equalsWord(value, length, "panic") ? LogfmtColorizer::fatalLevel : LogfmtColorizer::levelCount;
+		default:
+			return LogfmtColorizer::levelCount;
+	}
+}
+
+/**
+ * @brief Resolves the styles of the levels from the current theme, once per chunk rather than
+ * once per line; levels the theme leaves undefined keep their default colors.
+ */
+void LogfmtColorizer::resolveLevels(void) {
+	for (size_t level = 0 ; level < levelCount ; level++) {
+		const ColorFormat::Attributes themed = ThemeRegistry::attributes(_levels[level]);
+
+		_levelAttributes[level] = themed ? themed : defaultLevels[level];
+	}
+}
+
+/* ############################################################################################## */
+
+/**
+ * @brief Writes the bytes read since the last color change.
+ *
+ * Runs of up to 16 bytes are copied as a fixed block when the input has 16 readable bytes,
+ * which avoids a call to memcpy() for most tokens.
+ */
+void LogfmtColorizer::flush(const char *position) {
+	const size_t length = static_cast<size_t>(position - _run);
+
+	if (length <= 16 and _run + 16 <= _limit) {
+		std::memcpy(_output.acquire(16), _run, 16);
+		_output.advance(length);
+	} else
+		_output.append(_run, length);
+	_run = position;
+}
+
+/** Changes the color at a position of the line, if it differs from the current one. */
+void LogfmtColorizer::switchAt(const char *position, const size_t token) {
+	if (token != _current) {
+		flush(position);
+		switchTo(token);
+	}
+}
+
+void LogfmtColorizer::switchAtAttributes(const char *position, const ColorFormat::Attributes attributes) {
+	if (_current != otherToken or attributes != _currentAttributes) {
+		flush(position);
+		switchToAttributes(attributes);
+	}
+}
+
+#ifdef __SSE2__
+/**
+ * @brief Returns the index of the lowest bit set in a non-zero mask.
+ */
+static inline unsigned int lowestBit(unsigned int mask) {
+# if defined(__GNUC__)
+	return static_cast<unsigned int>(__builtin_ctz(mask));
+# else
+	unsigned int index = 0;
+
+	while (!(mask & 1)) {
+		mask >>= 1;
+		index++;
+	}
+	return index;
+# endif
+}
+#endif
+
+/**
+ * @brief Finds the first byte of a line equal to one of two bytes, or a blank when `blanks` is set.
+ *
+ * Blocks of 16 bytes are compared with SSE2 as long as they lie within the readable input.
+ *
+ * @return The byte found, or the end of the line.
+ */
+static inline const char *findByte(const char *position, const char *end, const char *limit, const char first, const char second, const bool blanks) {
+#ifdef __SSE2__
+	const __m128i firstBytes  = _mm_set1_epi8(first);
+	const __m128i secondBytes = _mm_set1_epi8(second);
+
+	for ( ; position < end and position + 16 <= limit ; position += 16) {
+		const __m128i block	  = _mm_loadu_si128(reinterpret_cast<const __m128i *>(position));
+		__m128i		  matches = _mm_or_si128(_mm_cmpeq_epi8(block, firstBytes), _mm_cmpeq_epi8(block, secondBytes));
+
+		if (blanks)
+			matches = _mm_or_si128(matches, _mm_or_si128(_mm_cmpeq_epi8(block, _mm_set1_epi8(' ')), _mm_cmpeq_epi8(block, _mm_set1_epi8('\t'))));
+
+		const unsigned int mask = static_cast<unsigned int>(_mm_movemask_epi8(matches));
+
+		if (mask)
+			return position + lowestBit(mask) < end ? position + lowestBit(mask) : end;
+	}
+#else
+	(void)limit;
+#endif
+	while (position < end and *position != first and *position != second and !(blanks and isBlank(*position)))
+		position++;
+	return position < end ? position : end;
+}
+
+/**
+ * @brief Finds the end of a quoted string, after its closing quote or at the end of the line.
+ */
+static const char *skipQuoted(const char *position, const char *end, const char *limit) {
+	for (position++ ; (position = findByte(position, end, limit, '"', '\\', false)) < end ; position += 2)
+		if (*position == '"')
+			return position + 1;
+	return end;
+}
+
+/**
+ * @brief Styles a value by its key: levels by severity, ranged keys with the gradient,
+ * quoted strings and other values with their token colors.
+ */
+void LogfmtColorizer::styleValue(const char *key, const size_t keyLength, const char *value, const size_t length) {
+	const bool quoted = value[0] == '"';
+
+	if ((keyLength == 5 and !std::memcmp(key, "level", 5)) or (keyLength == 3 and !std::memcmp(key, "lvl", 3))
+		or (keyLength == 8 and !std::memcmp(key, "severity", 8))) {
+		const size_t level = quoted ? findLevel(value + 1, length - 1 - (length > 1 and value[length - 1] == '"')) : findLevel(value, length);
+
+		if (level != levelCount) {
+			switchAtAttributes(value, _levelAttributes[level]);
+			return;
+		}
+	}
+	if (!quoted and value[0] >= '0' and value[0] <= '9')
+		for (size_t i = 0 ; i < _ranges.size() ; i++)
+			if (_ranges[i].key.size() == keyLength and !std::memcmp(_ranges[i].key.data(), key, keyLength)) {
+				uint64_t number = 0;
+
+				for (size_t digit = 0 ; digit < length and value[digit] >= '0' and value[digit] <= '9' and number <= 0xFFFFFFFFu ; digit++)
+					number = number * 10 + static_cast<uint64_t>(value[digit] - '0');
+
+				const int colorIndex = ColorFormat::gradientColorIndex(number > 0xFFFFFFFFu ? 0xFFFFFFFFu : static_cast<unsigned int>(number),
+																	   _ranges[i].minimum, _ranges[i].maximum);
+
+				if (colorIndex == ColorFormat::gradientTooLow)
+					switchAtAttributes(value, static_cast<ColorFormat::Attributes>(ColorFormat::red) | ColorFormat::blink | ColorFormat::bold);
+				else if (colorIndex == ColorFormat::gradientTooHigh)
+					switchAtAttributes(value, static_cast<ColorFormat::Attributes>(ColorFormat::green) | ColorFormat::blink | ColorFormat::bold);
+				else
+					switchAtAttributes(value, ColorFormat::palette(static_cast<unsigned int>(colorIndex)));
+				return;
+			}
+	switchAt(value, quoted ? stringToken : valueToken);
+}
+
+/**
+ * @brief Colors a complete line, without its newline.
+ *
+ * Each field is `key=value`, `key="quoted value"` (with backslash escapes) or a bare word,
+ * colored as a key. The bytes are copied in runs between color changes; blanks keep the
+ * current color.
+ *
+ * @param limit The end of the readable input, which may extend past the line.
+ */
+void LogfmtColorizer::writeLine(const char *line, const size_t length, const char *limit) {
+	const char *const end	   = line + length;
+	const char		  *position = line;
+
+	_run   = line;
+	_limit = limit;
+	while (position < end) {
+		if (isBlank(*position)) {
+			position++;
+			continue;
+		}
+		if (*position == '"') {
+			/* A quoted string without a key */
+			switchAt(position, stringToken);
+			position = skipQuoted(position, end, limit);
+			continue;
+		}
+
+		const char *const key = position;
+
+		position = findByte(position, end, limit, '=', ' ', true);
+		switchAt(key, keyToken);
+		if (position == end or *position != '=')
+			continue;
+
+		const char *const value = ++position;
+
+		if (position < end and *position == '"')
+			position = skipQuoted(position, end, limit);
+		else
+			position = findByte(position, end, limit, ' ', '\t', false);
+		if (position > value)
+			styleValue(key, static_cast<size_t>(value - key) - 1, value, static_cast<size_t>(position - value));
+	}
+	flush(end);
+	switchTo(noToken);
+}
+
+/* ############################################################################################## */
+
+/**
+ * @brief Colors the next chunk of the log.
+ *
+ * Complete lines are colored in place; the start of a line split across chunks is kept
+ * until its newline arrives.
+ *
+ * @param data The chunk, which can end anywhere in a line.
+ * @param length The size of the chunk.
+ */
+void LogfmtColorizer::write(const char *data, const size_t length) {
+	size_t i = 0;
+
+	resolveLevels();
+
+	while (i < length) {
+		const char *newline = static_cast<const char *>(std::memchr(data + i, '\n', length - i));
+
+		if (!newline) {
+			_pending.append(data + i, length - i);
+			return;
+		}
+
+		const size_t end = static_cast<size_t>(newline - data);
+
+		if (_pending.empty())
+			writeLine(data + i, end - i, data + length);
+		else {
+			_pending.append(data + i, end - i);
+			writeLine(_pending.data(), _pending.size(), _pending.data() + _pending.size());
+			_pending.clear();
+		}
+		_output.append('\n');
+		i = end + 1;
+	}
+}
+
+void LogfmtColorizer::finish(void) {
+	if (!_pending.empty()) {
+		resolveLevels();
+		writeLine(_pending.data(), _pending.size(), _pending.data() + _pending.size());
+		_pending.clear();
+	}
+	switchTo(noToken);
+}
+
+/* ############################################################################################## */
+
+void LogfmtColorizer::colorize(std::istream &input, std::ostream &output) {
+	BufferedWriter	writer(output);
+	LogfmtColorizer colorizer(writer);
+	char			chunk[1 << 14];
+
+	do {
+		input.read(chunk, sizeof(chunk));
+		colorizer.write(chunk, static_cast<size_t>(input.gcount()));
+	} while (input);
+	colorizer.finish();
+}
@@ -0,0 +1,147 @@
+#pragma once
+
+/* ############################################################################################## */
+
+/**
+ * @file LogfmtColorizer.hpp
+ * @brief Declaration of the LogfmtColorizer class, which colors logfmt lines as they stream.
+ *
+ * Keys, values and quoted strings get their own colors, `level=` values are styled by
+ * severity through the current theme, and numbers can follow the red to green gradient:
+ * ```
+ * BufferedWriter  output(std::cout);
+ * LogfmtColorizer colorizer(output);
+ * colorizer.range("dur", 500, 0);
+ * colorizer.write("level=error msg=\"disk full\" dur=12ms\n", 39);
+ * colorizer.finish();
+ * ```
+ * The severities are looked up as `level.trace`, `level.debug`, `level.info`, `level.warn`,
+ * `level.error` and `level.fatal` in the theme published to ThemeRegistry; names the theme
+ * leaves undefined keep the default colors.
+ *
+ * Requires C++11.
+ *
+ * @author aheitz
+ * @date Created: 2026-10-17
+ * @date Last Modified: 2026-10-17
+ */
+
+/* ############################################################################################## */
+
+/*
+ * This file is part of the ColorFormat library.
+ *
+ * Copyright (C) 2025 aheitz <alexy.pa.heitz@gmail.com>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+/* ############################################################################################## */
+
+#include "BufferedWriter.hpp"
+#include "ColorFormat.hpp"
+#include "ColorTheme.hpp"
+
+#include <istream>
+#include <ostream>
+#include <string>
+#include <vector>
+
+/* ############################################################################################## */
+
+/**
+ * @brief Streaming logfmt colorizer.
+ *
+ * Lines can be split across chunks; a partial line is kept until its end arrives.
+ */
+class LogfmtColorizer {
+	public:
+		enum Token { keyToken, valueToken, stringToken, tokenCount };
+
+		enum Level { traceLevel, debugLevel, infoLevel, warningLevel, errorLevel, fatalLevel, levelCount };
+
+		/**
+		 * @brief Creates a colorizer with the default colors: blue keys, plain values and green strings.
+		 */
+		explicit LogfmtColorizer(BufferedWriter &output);
+
+		/** @name Settings */
+		/** @{ */
+		LogfmtColorizer &color(Token token, ColorFormat::Attributes attributes);
+		ColorFormat::Attributes color(Token token) const;
+		/**
+		 * @brief Colors the numbers of a key with the gradient of formatGradientUnsignedInteger().
+		 *
+		 * Values starting with digits (`12ms`) are colored by their leading number.
+		 */
+		LogfmtColorizer &range(const std::string &key, unsigned int minimum, unsigned int maximum);
+		/** @} */
+
+		/** Colors the next chunk of the log. */
+		void write(const char *data, size_t length);
+
+		/** Colors a partial last line, if any, and resets the terminal. */
+		void finish(void);
+
+		/**
+		 * @brief Colors a whole stream, read in chunks.
+		 */
+		static void colorize(std::istream &input, std::ostream &output);
+	private:
+		enum { noToken = tokenCount, otherToken };
+
+		enum { cacheSize = 64 };
+
+		struct CachedTransition {
+			ColorFormat::Attributes	from;
+			ColorFormat::Attributes	to;
+			bool					valid;
+			unsigned char			length;
+			char					bytes[ColorFormat::transitionCapacity];
+		};
+
+		struct Range {
+			std::string		key;
+			unsigned int	minimum;
+			unsigned int	maximum;
+		};
+
+		BufferedWriter			&_output;
+		ColorFormat::Attributes	_palette[tokenCount + 1];
+		unsigned char			_transitionLengths[tokenCount + 1][tokenCount + 1];
+		char					_transitions[tokenCount + 1][tokenCount + 1][ColorFormat::transitionCapacity];
+		std::vector<Range>		_ranges;
+		ThemeRegistry::Handle	_levels[levelCount];
+		ColorFormat::Attributes	_levelAttributes[levelCount];	/**< Styles of the levels in the current theme */
+
+		size_t					_current;			/**< Token whose color is applied, otherToken for a level or a gradient */
+		ColorFormat::Attributes	_currentAttributes;
+		std::string				_pending;			/**< Start of a line split across chunks */
+		const char				*_run;				/**< First byte of the line not written yet */
+		const char				*_limit;			/**< End of the readable input */
+		CachedTransition		_cache[cacheSize];	/**< Transitions to level and gradient colors */
+
+		void prepareTransitions(void);
+		void switchTo(size_t token);
+		void switchToAttributes(ColorFormat::Attributes attributes);
+		void switchAt(const char *position, size_t token);
+		void switchAtAttributes(const char *position, ColorFormat::Attributes attributes);
+		void flush(const char *position);
+		void resolveLevels(void);
+		void writeLine(const char *line, size_t length, const char *limit);
+		void styleValue(const char *key, size_t keyLength, const char *value, size_t length);
+
+		LogfmtColorizer(const LogfmtColorizer &source) = delete;
+		LogfmtColorizer &operator=(const LogfmtColorizer &source) = delete;
+};
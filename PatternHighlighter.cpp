@@ -0,0 +1,800 @@
+#include "PatternHighlighter.hpp"
+
+/* ############################################################################################## */
+
+/**
+ * @file PatternHighlighter.cpp
+ * @brief Implementation of the PatternHighlighter class.
+ *
+ * This file contains the parser of the patterns, which builds a Thompson NFA, and the subset
+ * construction of the combined DFA over byte classes and of the reverse DFA that finds where
+ * matches start.
+ *
+ * @author aheitz
+ * @date Created: 2026-10-17
+ * @date Last Modified: 2026-10-17
+ */
+
+/* ############################################################################################## */
+
+/*
+ * This file is part of the ColorFormat library.
+ *
+ * Copyright (C) 2025 aheitz <alexy.pa.heitz@gmail.com>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+/* ############################################################################################## */
+
+#include <algorithm>
+#include <bitset>
+#include <map>
+#include <stdexcept>
+
+/* ############################################################################################## */
+
+namespace {
+	typedef std::bitset<256> ByteSet;
+
+	const size_t none = static_cast<size_t>(-1);
+
+	/**
+	 * @brief State of the NFA: a transition on a byte set and any number of empty transitions.
+	 */
+	struct Node {
+		size_t				set;		/**< Index of the byte set leading to next, or none */
+		size_t				next;
+		std::vector<size_t>	epsilon;
+		size_t				pattern;	/**< Pattern accepted in this state, or none */
+	};
+
+	/** Part of the NFA with a single entry and a single exit, which has no transition yet */
+	struct Fragment {
+		size_t start;
+		size_t end;
+	};
+
+	/**
+	 * @brief Thompson NFA of all the patterns.
+	 */
+	struct Automaton {
+		std::vector<Node>		nodes;
+		std::vector<ByteSet>	sets;
+		std::vector<size_t>		starts;			/**< Entry of each pattern */
+		std::vector<size_t>		ends;			/**< Accepting state of each pattern */
+		std::vector<bool>		anchored;		/**< Whether each pattern starts with `^` */
+
+		size_t node(void) {
+			Node added;
+
+			added.set	  = none;
+			added.next	  = none;
+			added.pattern = none;
+			nodes.push_back(added);
+			return nodes.size() - 1;
+		}
+
+		Fragment empty(void) {
+			const size_t single = node();
+
+			return make(single, single);
+		}
+
+		Fragment bytes(const ByteSet &set) {
+			const size_t start = node();
+			const size_t end   = node();
+
+			sets.push_back(set);
+			nodes[start].set  = sets.size() - 1;
+			nodes[start].next = end;
+			return make(start, end);
+		}
+
+		Fragment concatenate(const Fragment &first, const Fragment &second) {
+			nodes[first.end].epsilon.push_back(second.start);
+			return make(first.start, second.end);
+		}
+
+		Fragment alternate(const Fragment &first, const Fragment &second) {
+			const size_t start = node();
+			const size_t end   = node();
+
+			nodes[start].epsilon.push_back(first.start);
+			nodes[start].epsilon.push_back(second.start);
+			nodes[first.end].epsilon.push_back(end);
+			nodes[second.end].epsilon.push_back(end);
+			return make(start, end);
+		}
+
+		Fragment optional(const Fragment &fragment) {
+			const size_t start = node();
+			const size_t end   = node();
+
+			nodes[start].epsilon.push_back(fragment.start);
+			nodes[start].epsilon.push_back(end);
+			nodes[fragment.end].epsilon.push_back(end);
+			return make(start, end);
+		}
+
+		Fragment star(const Fragment &fragment) {
+			const size_t start = node();
+			const size_t end   = node();
+
+			nodes[start].epsilon.push_back(fragment.start);
+			nodes[start].epsilon.push_back(end);
+			nodes[fragment.end].epsilon.push_back(fragment.start);
+			nodes[fragment.end].epsilon.push_back(end);
+			return make(start, end);
+		}
+
+		static Fragment make(const size_t start, const size_t end) {
+			const Fragment fragment = {start, end};
+
+			return fragment;
+		}
+
+		/**
+		 * @brief Builds the automaton of the reversed patterns, whose entries are the ends of
+		 * the patterns and whose accepting states are their starts.
+		 *
+		 * Every state has at most one incoming byte transition, the end of a bytes() fragment
+		 * being reached from its start only, so the reversed states keep a single one.
+		 */
+		Automaton reversed(void) const {
+			Automaton reverse;
+
+			reverse.nodes.resize(nodes.size());
+			reverse.sets	 = sets;
+			reverse.starts	 = ends;
+			reverse.ends	 = starts;
+			reverse.anchored = anchored;
+			for (size_t state = 0 ; state < nodes.size() ; state++) {
+				reverse.nodes[state].set	 = none;
+				reverse.nodes[state].next	 = none;
+				reverse.nodes[state].pattern = none;
+			}
+			for (size_t state = 0 ; state < nodes.size() ; state++) {
+				if (nodes[state].set != none) {
+					reverse.nodes[nodes[state].next].set  = nodes[state].set;
+					reverse.nodes[nodes[state].next].next = state;
+				}
+				for (size_t i = 0 ; i < nodes[state].epsilon.size() ; i++)
+					reverse.nodes[nodes[state].epsilon[i]].epsilon.push_back(state);
+			}
+			for (size_t i = 0 ; i < starts.size() ; i++)
+				reverse.nodes[starts[i]].pattern = i;
+			return reverse;
+		}
+	};
+
+	/**
+	 * @brief Recursive descent parser of a pattern, adding its fragment to the automaton.
+	 *
+	 * Repetitions parse their atom again for each copy they need.
+	 */
+	class Parser {
+		public:
+			Parser(Automaton &automaton, const std::string &pattern) : _automaton(automaton), _pattern(pattern), _position(0) {}
+
+			Fragment parse(void) {
+				const Fragment fragment = alternation();
+
+				if (_position < _pattern.size())
+					fail("unbalanced parenthesis");
+				return fragment;
+			}
+
+			void skip(const size_t count) { _position += count; }
+		private:
+			Automaton			&_automaton;
+			const std::string	&_pattern;
+			size_t				_position;
+
+			void fail(const char *reason) const {
+				throw std::invalid_argument("❌ Invalid pattern \"" + _pattern + "\": " + reason + '.');
+			}
+
+			bool atEnd(void) const { return _position == _pattern.size(); }
+			char peek(void) const { return _pattern[_position]; }
+
+			Fragment alternation(void) {
+				Fragment fragment = sequence();
+
+				while (!atEnd() and peek() == '|') {
+					_position++;
+					fragment = _automaton.alternate(fragment, sequence());
+				}
+				return fragment;
+			}
+
+			Fragment sequence(void) {
+				Fragment fragment = _automaton.empty();
+
+				while (!atEnd() and peek() != '|' and peek() != ')')
+					fragment = _automaton.concatenate(fragment, repetition());
+				return fragment;
+			}
+
+			Fragment repetition(void) {
+				const size_t atomStart = _position;
+				Fragment	 fragment  = atom();
+
+				if (atEnd())
+					return fragment;
+				switch (peek()) {
+					case '*':
+						_position++;
+						fragment = _automaton.star(fragment);
+						break;
+					case '+':
+						_position++;
+						fragment = _automaton.concatenate(fragment, _automaton.star(copy(atomStart)));
+						break;
+					case '?':
+						_position++;
+						fragment = _automaton.optional(fragment);
+						break;
+					case '{':
+						fragment = bounded(fragment, atomStart);
+						break;
+					default:
+						return fragment;
+				}
+				if (!atEnd() and (peek() == '*' or peek() == '+' or peek() == '?' or peek() == '{'))
+					fail("stacked or lazy quantifiers are not supported");
+				return fragment;
+			}
+
+			/**
+			 * @brief Applies `{n}`, `{n,}` or `{n,m}` to the atom parsed from atomStart.
+			 */
+			Fragment bounded(Fragment fragment, const size_t atomStart) {
+				_position++;
+
+				const size_t minimum = number();
+				size_t		 maximum = minimum;
+				bool		 unbounded = false;
+
+				if (!atEnd() and peek() == ',') {
+					_position++;
+					if (!atEnd() and peek() == '}')
+						unbounded = true;
+					else
+						maximum = number();
+				}
+				if (atEnd() or peek() != '}')
+					fail("expected '}'");
+				_position++;
+				if (maximum < minimum)
+					fail("repetition bounds out of order");
+
+				const size_t end = _position;
+
+				if (!minimum)
+					fragment = _automaton.empty();
+				for (size_t i = 1 ; i < minimum ; i++)
+					fragment = _automaton.concatenate(fragment, copy(atomStart));
+				if (unbounded)
+					fragment = _automaton.concatenate(fragment, _automaton.star(copy(atomStart)));
+				for (size_t i = minimum ; i < maximum ; i++)
+					fragment = _automaton.concatenate(fragment, _automaton.optional(copy(atomStart)));
+				_position = end;
+				return fragment;
+			}
+
+			size_t number(void) {
+				size_t value  = 0;
+				size_t digits = 0;
+
+				for ( ; !atEnd() and peek() >= '0' and peek() <= '9' ; _position++, digits++)
+					if ((value = value * 10 + static_cast<size_t>(peek() - '0')) > static_cast<size_t>(PatternHighlighter::maximumRepetition))
+						fail("repetition count too large");
+				if (!digits)
+					fail("expected a repetition count");
+				return value;
+			}
+
+			/** Builds another copy of the atom starting at atomStart. */
+			Fragment copy(const size_t atomStart) {
+				const size_t position = _position;
+
+				_position = atomStart;
+
+				const Fragment fragment = atom();
+
+				_position = position;
+				return fragment;
+			}
+
+			Fragment atom(void) {
+				ByteSet set;
+
+				switch (_pattern[_position++]) {
+					case '(':
+						if (_pattern.compare(_position, 2, "?:") == 0)
+							_position += 2;
+						{
+							const Fragment fragment = alternation();
+
+							if (atEnd() or peek() != ')')
+								fail("missing ')'");
+							_position++;
+							return fragment;
+						}
+					case '[':
+						set = byteClass();
+						break;
+					case '.':
+						set.set();
+						set.reset('\n');
+						break;
+					case '\\':
+						set = escape();
+						break;
+					case '*': case '+': case '?': case '{':
+						fail("quantifier without an atom");
+						break;
+					case '^': case '$':
+						fail("anchors other than a leading '^' are not supported");
+						break;
+					default:
+						set.set(static_cast<unsigned char>(_pattern[_position - 1]));
+						break;
+				}
+				return _automaton.bytes(set);
+			}
+
+			/**
+			 * @brief Parses what follows a backslash: a class shorthand, a control character,
+			 * a byte in hexadecimal or an escaped punctuation character.
+			 */
+			ByteSet escape(void) {
+				ByteSet set;
+
+				if (atEnd())
+					fail("trailing backslash");
+
+				const char character = _pattern[_position++];
+
+				switch (character) {
+					case 'd': case 'D':
+						for (int byte = '0' ; byte <= '9' ; byte++)
+							set.set(byte);
+						break;
+					case 'w': case 'W':
+						for (int byte = 0 ; byte < 256 ; byte++)
+							if ((byte >= 'a' and byte <= 'z') or (byte >= 'A' and byte <= 'Z') or (byte >= '0' and byte <= '9') or byte == '_')
+								set.set(byte);
+						break;
+					case 's': case 'S':
+						set.set(' ').set('\t').set('\n').set('\r').set('\f').set('\v');
+						break;
+					case 'n':
+						return set.set('\n');
+					case 't':
+						return set.set('\t');
+					case 'r':
+						return set.set('\r');
+					case 'x': {
+						int value = 0;
+
+						for (int digit = 0 ; digit < 2 ; digit++, _position++) {
+							const char hex = atEnd() ? '\0' : peek();
+
+							if (hex >= '0' and hex <= '9')
+								value = value * 16 + hex - '0';
+							else if ((hex | 0x20) >= 'a' and (hex | 0x20) <= 'f')
+								value = value * 16 + (hex | 0x20) - 'a' + 10;
+							else
+								fail("expected two hexadecimal digits after \\x");
+						}
+						return set.set(value);
+					}
+					default:
+						if ((character >= 'a' and character <= 'z') or (character >= 'A' and character <= 'Z') or (character >= '0' and character <= '9'))
+							fail("unsupported escape");
+						return set.set(static_cast<unsigned char>(character));
+				}
+				return character >= 'A' and character <= 'Z' ? ~set : set;
+			}
+
+			/**
+			 * @brief Parses a bracket expression after its `[`.
+			 */
+			ByteSet byteClass(void) {
+				ByteSet set;
+				bool	negated = false;
+				bool	first	= true;
+
+				if (!atEnd() and peek() == '^') {
+					negated = true;
+					_position++;
+				}
+				while (true) {
+					if (atEnd())
+						fail("missing ']'");
+					if (peek() == ']' and !first)
+						break;
+					first = false;
+
+					ByteSet		  single;
+					unsigned char low;
+
+					if (peek() == '\\') {
+						_position++;
+						single = escape();
+						if (single.count() != 1) {
+							set |= single;
+							continue;
+						}
+					} else
+						single.set(static_cast<unsigned char>(_pattern[_position++]));
+					for (low = 0 ; !single.test(low) ; low++) ;
+					if (_position + 1 < _pattern.size() and peek() == '-' and _pattern[_position + 1] != ']') {
+						_position++;
+
+						unsigned char high;
+
+						if (peek() == '\\') {
+							_position++;
+
+							const ByteSet upper = escape();
+
+							if (upper.count() != 1)
+								fail("invalid range");
+							for (high = 0 ; !upper.test(high) ; high++) ;
+						} else
+							high = static_cast<unsigned char>(_pattern[_position++]);
+						if (high < low)
+							fail("range out of order");
+						for (unsigned int byte = low ; byte <= high ; byte++)
+							set.set(byte);
+					} else
+						set.set(low);
+				}
+				_position++;
+				return negated ? ~set : set;
+			}
+	};
+
+	/**
+	 * @brief Adds to a set of NFA states all the states reachable by empty transitions.
+	 */
+	void close(const Automaton &automaton, std::vector<size_t> &states) {
+		std::vector<bool>	seen(automaton.nodes.size(), false);
+		std::vector<size_t> pending(states);
+
+		states.clear();
+		while (!pending.empty()) {
+			const size_t state = pending.back();
+
+			pending.pop_back();
+			if (seen[state])
+				continue;
+			seen[state] = true;
+			states.push_back(state);
+			for (size_t i = 0 ; i < automaton.nodes[state].epsilon.size() ; i++)
+				pending.push_back(automaton.nodes[state].epsilon[i]);
+		}
+		std::sort(states.begin(), states.end());
+	}
+
+	/**
+	 * @brief Moves a set of NFA states over one byte, then closes the result.
+	 */
+	std::vector<size_t> move(const Automaton &automaton, const std::vector<size_t> &states, const unsigned char byte) {
+		std::vector<size_t> moved;
+
+		for (size_t i = 0 ; i < states.size() ; i++) {
+			const Node &node = automaton.nodes[states[i]];
+
+			if (node.set != none and automaton.sets[node.set].test(byte))
+				moved.push_back(node.next);
+		}
+		close(automaton, moved);
+		return moved;
+	}
+
+	/**
+	 * @brief DFA states built by subset construction, each a sorted set of NFA states.
+	 */
+	struct Subsets {
+		std::map<std::vector<size_t>, uint32_t> indices;
+		std::vector<std::vector<size_t> >		states;
+
+		/** State 0 is the empty set, the dead state. */
+		Subsets(void) : states(1) { indices[states[0]] = 0; }
+
+		/**
+		 * @throws std::length_error if the set is new and there are already maximumStates states.
+		 */
+		uint32_t index(const std::vector<size_t> &set) {
+			const std::map<std::vector<size_t>, uint32_t>::const_iterator found = indices.find(set);
+
+			if (found != indices.end())
+				return found->second;
+			if (states.size() == static_cast<size_t>(PatternHighlighter::maximumStates))
+				throw std::length_error("❌ The patterns need more DFA states than PatternHighlighter::maximumStates.");
+			indices[set] = static_cast<uint32_t>(states.size());
+			states.push_back(set);
+			return static_cast<uint32_t>(states.size() - 1);
+		}
+	};
+}
+
+/* ############################################################################################## */
+
+PatternHighlighter::PatternHighlighter(void) : _classCount(1), _start(0), _lineStart(0), _reverseStart(0) {
+	std::fill(_classes, _classes + 256, 0);
+}
+
+PatternHighlighter &PatternHighlighter::add(const std::string &pattern, const ColorFormat::Attributes attributes) {
+	char prefix[ColorFormat::prefixCapacity];
+
+	_patterns.push_back(pattern);
+	_attributes.push_back(attributes);
+	_prefixes.push_back(std::string(prefix, ColorFormat::writePrefix(attributes, prefix)));
+	try {
+		compile();
+	} catch (...) {
+		_patterns.pop_back();
+		_attributes.pop_back();
+		_prefixes.pop_back();
+		compile();
+		throw;
+	}
+	return *this;
+}
+
+/**
+ * @brief Adds a glob, translated to a pattern.
+ *
+ * Bracket expressions are kept; other special characters are escaped.
+ */
+PatternHighlighter &PatternHighlighter::addGlob(const std::string &glob, const ColorFormat::Attributes attributes) {
+	std::string pattern;
+
+	for (size_t i = 0 ; i < glob.size() ; i++) {
+		const char character = glob[i];
+
+		if (character == '*')
+			pattern += "\\S*";
+		else if (character == '?')
+			pattern += "\\S";
+		else if (character == '[') {
+			const size_t first = i + 1 + (i + 1 < glob.size() and glob[i + 1] == '!');
+			const size_t end   = glob.find(']', first + 1);
+
+			if (end == std::string::npos) {
+				pattern += "\\[";
+				continue;
+			}
+			pattern += first > i + 1 ? "[^" : "[";
+			pattern.append(glob, first, end + 1 - first);
+			i = end;
+		} else {
+			if (std::string("\\.+(){}|^$").find(character) != std::string::npos)
+				pattern += '\\';
+			pattern += character;
+		}
+	}
+	return add(pattern, attributes);
+}
+
+PatternHighlighter &PatternHighlighter::addLogPatterns(void) {
+	return add("[0-9a-fA-F]{8}-[0-9a-fA-F]{4}-[0-9a-fA-F]{4}-[0-9a-fA-F]{4}-[0-9a-fA-F]{12}", ColorFormat::yellow)
+		  .add("\\d{1,3}(\\.\\d{1,3}){3}(:\\d{1,5})?", ColorFormat::magenta)
+		  .add("0x[0-9a-fA-F]+|[0-9a-f]{12,}", ColorFormat::cyan)
+		  .add("[A-Za-z_][\\w.\\-]*=", ColorFormat::blue);
+}
+
+/* ############################################################################################## */
+
+/**
+ * @brief Builds the combined DFA of all the patterns.
+ *
+ * The bytes are first split into classes that no byte set of the NFA tells apart, so that
+ * the table has a column per class instead of per byte. The states are then built by subset
+ * construction, from two entries: one for the start of a line, where `^` patterns are tried,
+ * and one for the other positions.
+ */
+void PatternHighlighter::compile(void) {
+	Automaton automaton;
+
+	for (size_t i = 0 ; i < _patterns.size() ; i++) {
+		const bool anchored = !_patterns[i].empty() and _patterns[i][0] == '^';
+		Parser	   parser(automaton, _patterns[i]);
+
+		parser.skip(anchored);
+
+		const Fragment fragment = parser.parse();
+
+		automaton.nodes[fragment.end].pattern = i;
+		automaton.starts.push_back(fragment.start);
+		automaton.ends.push_back(fragment.end);
+		automaton.anchored.push_back(anchored);
+	}
+
+	/* Byte classes: refined by each set, two bytes stay together while every set holds both or neither */
+	std::fill(_classes, _classes + 256, 0);
+	_classCount = 1;
+	for (size_t set = 0 ; set < automaton.sets.size() ; set++) {
+		std::map<std::pair<size_t, bool>, size_t> refined;
+
+		for (size_t byte = 0 ; byte < 256 ; byte++) {
+			const std::pair<size_t, bool> key(_classes[byte], automaton.sets[set].test(byte));
+
+			if (refined.find(key) == refined.end()) {
+				const size_t index = refined.size();
+
+				refined[key] = index;
+			}
+			_classes[byte] = static_cast<unsigned char>(refined[key]);
+		}
+		_classCount = refined.size();
+	}
+
+	std::vector<unsigned char> representatives(_classCount);
+
+	for (size_t byte = 256 ; byte-- ; )
+		representatives[_classes[byte]] = static_cast<unsigned char>(byte);
+
+	/* Subset construction */
+	Subsets				subsets;
+	std::vector<size_t> entries[2];
+
+	for (size_t i = 0 ; i < automaton.starts.size() ; i++) {
+		if (!automaton.anchored[i])
+			entries[0].push_back(automaton.starts[i]);
+		entries[1].push_back(automaton.starts[i]);
+	}
+
+	uint32_t entryRows[2];
+
+	for (int entry = 0 ; entry < 2 ; entry++) {
+		close(automaton, entries[entry]);
+		entryRows[entry] = subsets.index(entries[entry]);
+	}
+
+	std::vector<uint32_t> next;
+
+	for (size_t state = 0 ; state < subsets.states.size() ; state++)
+		for (size_t byteClass = 0 ; byteClass < _classCount ; byteClass++)
+			next.push_back(subsets.index(move(automaton, subsets.states[state], representatives[byteClass])));
+
+	const std::vector<std::vector<size_t> > &states = subsets.states;
+
+	/* Accepted pattern of each state: the first one added among those reached */
+	_accepting.assign(states.size(), 0);
+	for (size_t state = 0 ; state < states.size() ; state++) {
+		size_t accepted = none;
+
+		for (size_t i = 0 ; i < states[state].size() ; i++)
+			accepted = std::min(accepted, automaton.nodes[states[state][i]].pattern);
+		_accepting[state] = accepted == none ? 0 : static_cast<uint32_t>(accepted + 1);
+	}
+
+	_table.resize(next.size());
+	for (size_t i = 0 ; i < next.size() ; i++)
+		_table[i] = static_cast<uint32_t>(next[i] * _classCount) << 1 | (_accepting[next[i]] != 0);
+	_start	   = static_cast<uint32_t>(entryRows[0] * _classCount) << 1;
+	_lineStart = static_cast<uint32_t>(entryRows[1] * _classCount) << 1;
+
+	/*
+	 * Reverse DFA, read from the end of a line: the ends of all the patterns are added back
+	 * after each byte, so its states hold every match ending anywhere after. The accept bits
+	 * of a transition come from the states reached before that restart, so that a start is
+	 * only reported for a match of at least one byte.
+	 */
+	const Automaton		reverse = automaton.reversed();
+	Subsets				reverseSubsets;
+	std::vector<size_t> restart(reverse.starts);
+
+	close(reverse, restart);
+	_reverseStart = reverseSubsets.index(restart) * static_cast<uint32_t>(_classCount) << 2;
+	_reverseTable.clear();
+	for (size_t state = 0 ; state < reverseSubsets.states.size() ; state++)
+		for (size_t byteClass = 0 ; byteClass < _classCount ; byteClass++) {
+			std::vector<size_t> moved  = move(reverse, reverseSubsets.states[state], representatives[byteClass]);
+			uint32_t			accept = 0;
+
+			for (size_t i = 0 ; i < moved.size() ; i++)
+				if (reverse.nodes[moved[i]].pattern != none)
+					accept |= reverse.anchored[reverse.nodes[moved[i]].pattern] ? reverseAnchoredAccept : reverseAccept;
+			moved.insert(moved.end(), restart.begin(), restart.end());
+			std::sort(moved.begin(), moved.end());
+			moved.erase(std::unique(moved.begin(), moved.end()), moved.end());
+			_reverseTable.push_back(reverseSubsets.index(moved) * static_cast<uint32_t>(_classCount) << 2 | accept);
+		}
+}
+
+/* ############################################################################################## */
+
+/**
+ * @brief Finds the leftmost-longest match starting at or after `start`.
+ *
+ * The reverse DFA reads the line from its end down to `start` once, the last position where
+ * it accepts being the leftmost start; the longest match is then read from there.
+ */
+size_t PatternHighlighter::find(const char *line, const size_t length, size_t &start, size_t &pattern) const {
+	if (_patterns.empty())
+		return 0;
+
+	const unsigned char *bytes	  = reinterpret_cast<const unsigned char *>(line);
+	const uint32_t		*table	  = &_reverseTable[0];
+	uint32_t			 entry	  = _reverseStart;
+	size_t				 leftmost = length;
+
+	for (size_t i = length ; i-- > start ; ) {
+		entry = table[(entry >> 2) + _classes[bytes[i]]];
+		if (entry & (i ? reverseAccept : reverseAccept | reverseAnchoredAccept))
+			leftmost = i;
+	}
+	if (leftmost == length)
+		return 0;
+	start = leftmost;
+	return longest(line, length, start, pattern);
+}
+
+void PatternHighlighter::markStarts(const char *line, const size_t length, uint64_t *starts) const {
+	const unsigned char *bytes = reinterpret_cast<const unsigned char *>(line);
+	const uint32_t		*table = &_reverseTable[0];
+	uint32_t			 entry = _reverseStart;
+
+	std::fill(starts, starts + (length + 63) / 64, 0);
+	for (size_t i = length ; i-- ; ) {
+		entry = table[(entry >> 2) + _classes[bytes[i]]];
+		if (entry & (i ? reverseAccept : reverseAccept | reverseAnchoredAccept))
+			starts[i / 64] |= static_cast<uint64_t>(1) << (i % 64);
+	}
+}
+
+/**
+ * @brief Runs the DFA from a position where a match is known to start until it dies.
+ */
+size_t PatternHighlighter::longest(const char *line, const size_t length, const size_t position, size_t &pattern) const {
+	const unsigned char *bytes = reinterpret_cast<const unsigned char *>(line);
+	const uint32_t		*table = &_table[0];
+	uint32_t			 entry = position ? _start : _lineStart;
+	size_t				 end   = position;
+	uint32_t			 last  = 0;
+
+	for (size_t i = position ; i < length ; i++) {
+		entry = table[(entry >> 1) + _classes[bytes[i]]];
+		if (entry & 1) {
+			end	 = i + 1;
+			last = entry;
+		} else if (!entry)
+			break;
+	}
+	if (end > position)
+		pattern = _accepting[(last >> 1) / _classCount] - 1;
+	return end - position;
+}
+
+void PatternHighlighter::write(const char *line, const size_t length, BufferedWriter &output) const { append(output, line, length); }
+
+std::string PatternHighlighter::highlight(const std::string &line) const {
+	std::string output;
+
+	output.reserve(line.size() + line.size() / 4);
+	return append(output, line.data(), line.size());
+}
+
+size_t PatternHighlighter::patternCount(void) const { return _patterns.size(); }
+
+size_t PatternHighlighter::stateCount(void) const { return _accepting.size(); }
+
+size_t PatternHighlighter::byteClassCount(void) const { return _classCount; }
@@ -0,0 +1,215 @@
+#pragma once
+
+/* ############################################################################################## */
+
+/**
+ * @file PatternHighlighter.hpp
+ * @brief Declaration of the PatternHighlighter class, which colors the matches of patterns in lines.
+ *
+ * The patterns are compiled together into a single DFA over byte classes, so a line is
+ * matched against all of them at once. A second DFA of the reversed patterns reads each line
+ * backwards once to mark where matches start, so the forward DFA only runs from those positions:
+ * ```
+ * PatternHighlighter highlighter;
+ * highlighter.add("\\d{1,3}(\\.\\d{1,3}){3}", ColorFormat::magenta)
+ *            .add("[A-Za-z_][\\w.]*=", ColorFormat::blue);
+ * std::cout << highlighter.highlight("connect host=10.0.0.1") << std::endl;
+ * ```
+ * The supported syntax is a subset of regular expressions: literals, `.`, classes
+ * (`[a-z]`, `[^"]`), `\d \w \s` and their negations, `\xHH`, groups, `|`, `* + ?`,
+ * `{n}`, `{n,}`, `{n,m}` and a leading `^` for the start of the line. Globs are also
+ * accepted, `*` and `?` standing for non-blank characters.
+ *
+ * @author aheitz
+ * @date Created: 2026-10-17
+ * @date Last Modified: 2026-10-17
+ */
+
+/* ############################################################################################## */
+
+/*
+ * This file is part of the ColorFormat library.
+ *
+ * Copyright (C) 2025 aheitz <alexy.pa.heitz@gmail.com>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+/* ############################################################################################## */
+
+#include "BufferedWriter.hpp"
+#include "ColorFormat.hpp"
+
+#include <string>
+#include <vector>
+
+/* ############################################################################################## */
+
+/**
+ * @brief Highlighter of the leftmost-longest matches of a set of patterns.
+ *
+ * When several patterns match the same longest text, the one added first wins.
+ */
+class PatternHighlighter {
+	public:
+		enum {
+			/** Largest DFA built; patterns needing more states are rejected */
+			maximumStates = 4096,
+			/** Largest count of a `{n,m}` repetition */
+			maximumRepetition = 255
+		};
+
+		PatternHighlighter(void);
+
+		/**
+		 * @brief Adds a pattern and recompiles the DFA.
+		 * @throws std::invalid_argument if the pattern is malformed or uses unsupported syntax.
+		 * @throws std::length_error if the patterns need more than maximumStates states.
+		 */
+		PatternHighlighter &add(const std::string &pattern, ColorFormat::Attributes attributes);
+
+		/**
+		 * @brief Adds a glob: `*` matches any run of non-blank characters and `?` one of them.
+		 */
+		PatternHighlighter &addGlob(const std::string &glob, ColorFormat::Attributes attributes);
+
+		/**
+		 * @brief Adds patterns for common log values: UUIDs, IPv4 addresses, hexadecimal
+		 * identifiers and `key=` prefixes.
+		 */
+		PatternHighlighter &addLogPatterns(void);
+
+		/**
+		 * @brief Finds the leftmost-longest match starting at or after `start`.
+		 *
+		 * Each call reads the line backwards from its end: append() reads it once for all
+		 * its matches.
+		 *
+		 * @param start Where to start, then the start of the match.
+		 * @param pattern Receives the index of the matching pattern.
+		 * @return The length of the match, 0 if there is none.
+		 */
+		size_t find(const char *line, size_t length, size_t &start, size_t &pattern) const;
+
+		/** @name Highlighting of a line */
+		/** @{ */
+		template <typename String>
+		String &append(String &output, const char *line, size_t length) const;
+		void write(const char *line, size_t length, BufferedWriter &output) const;
+		std::string highlight(const std::string &line) const;
+		/** @} */
+
+		size_t patternCount(void) const;
+		/** Retrieves the number of DFA states, the dead state included. */
+		size_t stateCount(void) const;
+		/** Retrieves the number of byte classes: bytes of a class are never told apart by the patterns. */
+		size_t byteClassCount(void) const;
+	private:
+		std::vector<std::string>				_patterns;
+		std::vector<ColorFormat::Attributes>	_attributes;
+		std::vector<std::string>				_prefixes;
+
+		/*
+		 * DFA: each entry of the table is the row of the next state (its index times the number
+		 * of classes) shifted left once, with the lowest bit set if that state accepts.
+		 * Row 0 is the dead state.
+		 */
+		unsigned char			_classes[256];
+		size_t					_classCount;
+		std::vector<uint32_t>	_table;
+		std::vector<uint32_t>	_accepting;		/**< Pattern accepted by each state */
+		uint32_t				_start;			/**< Entry used inside a line */
+		uint32_t				_lineStart;		/**< Entry used at the start of a line, where `^` patterns can match */
+
+		/*
+		 * Reverse DFA: the entries hold the next row shifted left twice, with reverseAccept set
+		 * when a match of a pattern starts at the byte just read, and reverseAnchoredAccept when
+		 * only a `^` pattern does. It never dies, as it looks for matches ending anywhere.
+		 */
+		enum { reverseAccept = 1, reverseAnchoredAccept = 2 };
+
+		std::vector<uint32_t>	_reverseTable;
+		uint32_t				_reverseStart;	/**< Entry used at the end of a line */
+
+		void compile(void);
+
+		/**
+		 * @brief Sets the bit of each position of a line where a match starts.
+		 * @param starts The bits, of at least `(length + 63) / 64` words.
+		 */
+		void markStarts(const char *line, size_t length, uint64_t *starts) const;
+
+		/**
+		 * @brief Retrieves the length of the longest match starting at a position.
+		 * @param pattern Receives the index of the matching pattern.
+		 */
+		size_t longest(const char *line, size_t length, size_t position, size_t &pattern) const;
+};
+
+/* ############################################################################################## */
+
+template <typename String>
+String &PatternHighlighter::append(String &output, const char *line, const size_t length) const {
+	static const char		reset[] = "\033[0m";
+	ColorFormat::Attributes current = 0;
+	char					transition[ColorFormat::transitionCapacity];
+	uint64_t				local[64];
+	std::vector<uint64_t>	allocated;
+	uint64_t				*starts	 = local;
+	size_t					position = 0;
+	size_t					pattern	 = 0;
+
+	if (_patterns.empty()) {
+		output.append(line, length);
+		return output;
+	}
+	if (length > sizeof(local) * 8) {
+		allocated.resize((length + 63) / 64);
+		starts = &allocated[0];
+	}
+	markStarts(line, length, starts);
+	for (size_t start = 0 ; start < length ; start++) {
+		const uint64_t bits = starts[start / 64] >> (start % 64);
+
+		if (!bits) {
+			start |= 63;
+			continue;
+		}
+		if (!(bits & 1))
+			continue;
+
+		const size_t matched = longest(line, length, start, pattern);
+
+		if (start > position) {
+			if (current)
+				output.append(reset, sizeof(reset) - 1);
+			current = 0;
+			output.append(line + position, start - position);
+		}
+		if (_attributes[pattern] != current) {
+			if (current)
+				output.append(transition, ColorFormat::writeTransition(current, _attributes[pattern], transition));
+			else
+				output.append(_prefixes[pattern].data(), _prefixes[pattern].size());
+			current = _attributes[pattern];
+		}
+		output.append(line + start, matched);
+		position = start + matched;
+		start	 = position - 1;
+	}
+	if (current)
+		output.append(reset, sizeof(reset) - 1);
+	output.append(line + position, length - position);
+	return output;
+}
@@ -0,0 +1,150 @@
+#include "RainbowStream.hpp"
+
+/* ############################################################################################## */
+
+/**
+ * @file RainbowStream.cpp
+ * @brief Implementation of the RainbowStream class.
+ *
+ * The escape sequences of the six colors are prepared once; the text is then written in
+ * slices, each into room acquired from the writer, so that no call allocates.
+ *
+ * @author aheitz
+ * @date Created: 2026-10-17
+ * @date Last Modified: 2026-10-17
+ */
+
+/* ############################################################################################## */
+
+/*
+ * This file is part of the ColorFormat library.
+ *
+ * Copyright (C) 2025 aheitz <alexy.pa.heitz@gmail.com>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+/* ############################################################################################## */
+
+#include <cstring>
+#include <stdexcept>
+
+/* ############################################################################################## */
+
+RainbowStream::RainbowStream(BufferedWriter &output, const ColorFormat::Attributes styles)
+	: _output(output), _styles(styles), _phase(0), _state(plainText), _started(false) {
+	if (styles & ~ColorFormat::styleMask)
+		throw std::invalid_argument("❌ No color is authorized with the rainbow function.");
+	restart();
+}
+
+void RainbowStream::restart(void) {
+	unsigned char colors[6];
+
+	ColorFormat::shuffleRainbow(colors);
+	for (size_t i = 0 ; i < 6 ; i++) {
+		_escapes[i][0] = '\033';
+		_escapes[i][1] = '[';
+		_escapes[i][2] = '3';
+		_escapes[i][3] = static_cast<char>('0' + colors[i] - 30);
+		_escapes[i][4] = 'm';
+	}
+	_phase = 0;
+}
+
+size_t RainbowStream::phase(void) const { return _phase; }
+
+/* ############################################################################################## */
+
+/**
+ * @brief Writes a visible character with the next color, after the styles for the first one.
+ * @return The end of the written bytes.
+ */
+char *RainbowStream::writeCharacter(char *output, const char character) {
+	if (!_started) {
+		output	+= ColorFormat::writePrefix(_styles, output);
+		_started = true;
+	}
+	std::memcpy(output, _escapes[_phase], escapeLength);
+	output[escapeLength] = character;
+	_phase = _phase == 5 ? 0 : _phase + 1;
+	return output + escapeLength + 1;
+}
+
+void RainbowStream::write(const char *data, const size_t length) {
+	/* A byte writes at most a held back ESC and itself, each with its color */
+	const size_t reserve = static_cast<size_t>(ColorFormat::prefixCapacity) + escapeLength + 1;
+	const size_t slice	 = _output.capacity() > reserve + escapeLength + 1
+						 ? (_output.capacity() - reserve) / (escapeLength + 1) : 1;
+
+	for (size_t start = 0 ; start < length ; start += slice) {
+		const size_t count	= length - start < slice ? length - start : slice;
+		char *const	 begin	= _output.acquire(count * (escapeLength + 1) + reserve);
+		char		 *output = begin;
+
+		for (size_t i = start ; i < start + count ; i++) {
+			const char character = data[i];
+
+			if (_state == escapeSequence) {
+				if (character == 'm')
+					_state = plainText;
+				continue;
+			}
+			if (_state == escapeStart) {
+				_state = plainText;
+				if (character == '[') {
+					_state = escapeSequence;
+					continue;
+				}
+				output = writeCharacter(output, '\033');
+			}
+			if (character == '\033')
+				_state = escapeStart;
+			else if (character == '\n' or (static_cast<unsigned char>(character) & 0xC0) == 0x80)
+				*output++ = character;
+			else
+				output = writeCharacter(output, character);
+		}
+		_output.advance(static_cast<size_t>(output - begin));
+	}
+}
+
+void RainbowStream::finish(void) {
+	char *const begin  = _output.acquire(static_cast<size_t>(ColorFormat::prefixCapacity) + escapeLength + 1 + 4);
+	char		*output = begin;
+
+	if (_state == escapeStart)
+		output = writeCharacter(output, '\033');
+	_state = plainText;
+	if (_started) {
+		std::memcpy(output, "\033[0m", 4);
+		output	+= 4;
+		_started = false;
+	}
+	_output.advance(static_cast<size_t>(output - begin));
+}
+
+/* ############################################################################################## */
+
+void RainbowStream::colorize(std::istream &input, std::ostream &output, const ColorFormat::Attributes styles) {
+	BufferedWriter writer(output);
+	RainbowStream  rainbow(writer, styles);
+	char		   chunk[1 << 14];
+
+	do {
+		input.read(chunk, sizeof(chunk));
+		rainbow.write(chunk, static_cast<size_t>(input.gcount()));
+	} while (input);
+	rainbow.finish();
+}
@@ -0,0 +1,107 @@
+#pragma once
+
+/* ############################################################################################## */
+
+/**
+ * @file RainbowStream.hpp
+ * @brief Declaration of the RainbowStream class, which colors streamed text as rainbow() does.
+ *
+ * Unlike rainbow(), the order of the colors and the position in it are kept from one call
+ * to the next, so a banner written line by line or a stream read in chunks cycles smoothly:
+ * ```
+ * BufferedWriter output(std::cout);
+ * RainbowStream  rainbow(output, ColorFormat::bold);
+ * rainbow.write("Hello, ", 7);
+ * rainbow.write("world!\n", 7);
+ * rainbow.finish();
+ * ```
+ * Escape sequences already in the text are removed, even when split across chunks.
+ *
+ * @author aheitz
+ * @date Created: 2026-10-17
+ * @date Last Modified: 2026-10-17
+ */
+
+/* ############################################################################################## */
+
+/*
+ * This file is part of the ColorFormat library.
+ *
+ * Copyright (C) 2025 aheitz <alexy.pa.heitz@gmail.com>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+/* ############################################################################################## */
+
+#include "BufferedWriter.hpp"
+#include "ColorFormat.hpp"
+
+#include <istream>
+#include <ostream>
+
+/* ############################################################################################## */
+
+/**
+ * @brief Streaming rainbow, with a color per character (UTF-8 code point).
+ *
+ * Line feeds are copied without a color and do not move the cycle forward.
+ */
+class RainbowStream {
+	public:
+		/**
+		 * @brief Creates a stream with a newly drawn order of colors.
+		 * @throws std::invalid_argument if `styles` holds a color.
+		 */
+		explicit RainbowStream(BufferedWriter &output, ColorFormat::Attributes styles = 0);
+
+		/** Colors the next chunk of text. */
+		void write(const char *data, size_t length);
+
+		/**
+		 * @brief Resets the terminal if anything was colored.
+		 *
+		 * The next write continues the cycle where it stopped. An escape sequence left
+		 * unterminated is dropped.
+		 */
+		void finish(void);
+
+		/** Draws a new order of colors and starts the cycle again. */
+		void restart(void);
+
+		/** Retrieves the position in the cycle of the next character, from 0 to 5. */
+		size_t phase(void) const;
+
+		/**
+		 * @brief Colors a whole stream, read in chunks.
+		 */
+		static void colorize(std::istream &input, std::ostream &output, ColorFormat::Attributes styles = 0);
+	private:
+		enum { escapeLength = 5 };
+
+		/** Where the previous chunk stopped */
+		enum State { plainText, escapeStart, escapeSequence };
+
+		BufferedWriter			&_output;
+		ColorFormat::Attributes	_styles;
+		char					_escapes[6][escapeLength];	/**< `\033[3Xm` of each color, in their drawn order */
+		size_t					_phase;
+		State					_state;
+		bool					_started;					/**< Whether something was colored since the last reset */
+
+		char *writeCharacter(char *output, char character);
+
+		RainbowStream(const RainbowStream &source);
+		RainbowStream &operator=(const RainbowStream &source);
+};
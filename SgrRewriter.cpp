@@ -0,0 +1,312 @@
+#include "SgrRewriter.hpp"
+
+/* ############################################################################################## */
+
+/**
+ * @file SgrRewriter.cpp
+ * @brief Implementation of the SgrRewriter class.
+ *
+ * The text between escape sequences is copied in bulk. The mapping of a set of attributes
+ * is kept in a small direct-mapped cache, as a stream only shows a handful of them, and
+ * palette colors are brought down to the basic ones through a table built once.
+ *
+ * @author aheitz
+ * @date Created: 2026-10-17
+ * @date Last Modified: 2026-10-17
+ */
+
+/* ############################################################################################## */
+
+/*
+ * This file is part of the ColorFormat library.
+ *
+ * Copyright (C) 2025 aheitz <alexy.pa.heitz@gmail.com>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+/* ############################################################################################## */
+
+#include <cstring>
+#include <stdexcept>
+
+/* ############################################################################################## */
+
+/**
+ * @brief Computes the squared distance between two 0xRRGGBB values.
+ */
+static unsigned int colorDistance(const unsigned int first, const unsigned int second) {
+	const int red	= static_cast<int>(first >> 16) - static_cast<int>(second >> 16);
+	const int green = static_cast<int>(first >> 8 & 0xFF) - static_cast<int>(second >> 8 & 0xFF);
+	const int blue	= static_cast<int>(first & 0xFF) - static_cast<int>(second & 0xFF);
+
+	return static_cast<unsigned int>(red * red + green * green + blue * blue);
+}
+
+static ColorFormat::Attributes basicColor(const unsigned int index) {
+	return static_cast<ColorFormat::Attributes>(ColorFormat::basicColor) << ColorFormat::foregroundKindShift
+		 | static_cast<ColorFormat::Attributes>(index) << ColorFormat::foregroundShift;
+}
+
+/* ############################################################################################## */
+
+SgrRewriter::SgrRewriter(BufferedWriter &output)
+	: _output(output), _mappedStyles(0), _depth(trueColorDepth), _state(plainText), _source(0), _shown(0), _read(0), _start(output.size()) {
+	for (unsigned int index = 0 ; index < 256 ; index++) {
+		const unsigned int value   = ColorFormat::colorValue(ColorFormat::palette(index));
+		unsigned int	   nearest = index < 16 ? index : 0;
+
+		if (index >= 16)
+			for (unsigned int basic = 1 ; basic < 16 ; basic++)
+				if (colorDistance(value, ColorFormat::colorValue(basicColor(basic))) < colorDistance(value, ColorFormat::colorValue(basicColor(nearest))))
+					nearest = basic;
+		_paletteToBasic[index] = static_cast<unsigned char>(nearest);
+	}
+	clear();
+}
+
+SgrRewriter &SgrRewriter::mapColor(const ColorFormat::Attributes color, const ColorFormat::Attributes replacement) {
+	if (not color or color & ~ColorFormat::foregroundMask or replacement & ~ColorFormat::foregroundMask)
+		throw std::invalid_argument("❌ A color can only be mapped from a foreground color to a foreground color.");
+	for (size_t i = 0 ; i < _colors.size() ; i++)
+		if (_colors[i].first == color) {
+			_colors[i].second = replacement;
+			invalidate();
+			return *this;
+		}
+	_colors.push_back(ColorMapping(color, replacement));
+	invalidate();
+	return *this;
+}
+
+SgrRewriter &SgrRewriter::mapStyle(const ColorFormat::Attributes style, const ColorFormat::Attributes replacement) {
+	if (not style or style & ~ColorFormat::styleMask or style & (style - 1))
+		throw std::invalid_argument("❌ Only a single style can be mapped.");
+	for (size_t i = 0 ; i < ColorFormat::styleCount ; i++)
+		if (style == static_cast<ColorFormat::Attributes>(1) << i)
+			_styles[i] = replacement;
+	_mappedStyles |= style;
+	invalidate();
+	return *this;
+}
+
+SgrRewriter &SgrRewriter::depth(const ColorDepth depth) {
+	_depth = depth;
+	invalidate();
+	return *this;
+}
+
+SgrRewriter &SgrRewriter::clear(void) {
+	_colors.clear();
+	for (size_t i = 0 ; i < ColorFormat::styleCount ; i++)
+		_styles[i] = 0;
+	_mappedStyles = 0;
+	_depth		  = trueColorDepth;
+	invalidate();
+	return *this;
+}
+
+size_t SgrRewriter::bytesRead(void) const { return _read; }
+
+size_t SgrRewriter::bytesWritten(void) const { return _output.size() - _start; }
+
+ptrdiff_t SgrRewriter::bytesSaved(void) const { return static_cast<ptrdiff_t>(_read) - static_cast<ptrdiff_t>(bytesWritten()); }
+
+std::string SgrRewriter::minimize(const std::string &text) {
+	std::string result;
+	{
+		BufferedWriter output(result);
+		SgrRewriter	   rewriter(output);
+
+		rewriter.write(text.data(), text.size());
+		rewriter.finish();
+	}
+	return result;
+}
+
+unsigned int SgrRewriter::nearestPaletteIndex(const unsigned int value) {
+	static const unsigned int cubeLevels[6] = {0x00, 0x5F, 0x87, 0xAF, 0xD7, 0xFF};
+	unsigned int			  cube[3];
+	unsigned int			  cubeValue = 0;
+
+	for (size_t i = 0 ; i < 3 ; i++) {
+		const unsigned int channel = value >> (16 - 8 * i) & 0xFF;
+
+		cube[i]	  = channel < 48 ? 0 : channel < 115 ? 1 : (channel - 35) / 40;
+		cubeValue = cubeValue << 8 | cubeLevels[cube[i]];
+	}
+
+	const unsigned int average	 = ((value >> 16) + (value >> 8 & 0xFF) + (value & 0xFF)) / 3;
+	const unsigned int gray		 = average < 8 ? 0 : average > 238 ? 23 : (average - 3) / 10;
+	const unsigned int grayLevel = 8 + gray * 10;
+
+	if (colorDistance(value, grayLevel << 16 | grayLevel << 8 | grayLevel) < colorDistance(value, cubeValue))
+		return 232 + gray;
+	return 16 + cube[0] * 36 + cube[1] * 6 + cube[2];
+}
+
+/* ############################################################################################## */
+
+/**
+ * @brief Maps a foreground color through the color mappings, then brings it down to the depth.
+ */
+ColorFormat::Attributes SgrRewriter::mapColor(ColorFormat::Attributes color) const {
+	if (not color)
+		return 0;
+	for (size_t i = 0 ; i < _colors.size() ; i++)
+		if (_colors[i].first == color) {
+			color = _colors[i].second;
+			break;
+		}
+
+	const unsigned int kind	 = static_cast<unsigned int>(color >> ColorFormat::foregroundKindShift & 3);
+	const unsigned int value = static_cast<unsigned int>(color >> ColorFormat::foregroundShift & 0xFFFFFF);
+
+	if (_depth == noColorDepth)
+		return 0;
+	if (_depth == trueColorDepth or kind == ColorFormat::basicColor or (kind == ColorFormat::paletteColor and _depth == paletteDepth))
+		return color;
+
+	const unsigned int index = kind == ColorFormat::rgbColor ? nearestPaletteIndex(value) : value;
+
+	return _depth == paletteDepth ? ColorFormat::palette(index) : basicColor(_paletteToBasic[index]);
+}
+
+ColorFormat::Attributes SgrRewriter::map(const ColorFormat::Attributes attributes) const {
+	ColorFormat::Attributes result		 = attributes;
+	ColorFormat::Attributes replacements = 0;
+
+	for (size_t i = 0 ; i < ColorFormat::styleCount ; i++)
+		if (attributes & _mappedStyles & static_cast<ColorFormat::Attributes>(1) << i) {
+			result		 &= ~(static_cast<ColorFormat::Attributes>(1) << i);
+			replacements |= _styles[i];
+		}
+	result = (result & ColorFormat::styleMask) | (replacements & ColorFormat::styleMask)
+		   | mapColor(replacements & ColorFormat::foregroundMask ? replacements & ColorFormat::foregroundMask : result & ColorFormat::foregroundMask)
+		   | ColorFormat::background(mapColor(ColorFormat::foreground(replacements & ColorFormat::backgroundMask
+																	? replacements & ColorFormat::backgroundMask : result & ColorFormat::backgroundMask)));
+	return result;
+}
+
+/**
+ * @brief Maps attributes through the cache.
+ */
+ColorFormat::Attributes SgrRewriter::mapped(const ColorFormat::Attributes attributes) {
+	CachedMapping &entry = _cache[static_cast<size_t>((attributes ^ attributes >> 17 ^ attributes >> 40) * 2654435761u) & (cacheSize - 1)];
+
+	if (not entry.valid or entry.from != attributes) {
+		entry.from	= attributes;
+		entry.to	= map(attributes);
+		entry.valid = true;
+	}
+	return entry.to;
+}
+
+void SgrRewriter::invalidate(void) {
+	for (size_t i = 0 ; i < cacheSize ; i++)
+		_cache[i].valid = false;
+}
+
+/* ############################################################################################## */
+
+/**
+ * @brief Writes the attributes set by the stream, once mapped, if they are not the ones shown.
+ */
+void SgrRewriter::show(void) {
+	const ColorFormat::Attributes target = mapped(_source);
+
+	if (target != _shown) {
+		_output.advance(ColorFormat::writeDelta(_shown, target, _output.acquire(ColorFormat::deltaCapacity)));
+		_shown = target;
+	}
+}
+
+/**
+ * @brief Copies the sequence being read unchanged, as it is not one that sets attributes.
+ */
+void SgrRewriter::abandonSequence(void) {
+	show();
+	_output.append("\033[", 2);
+	_output.append(_parameters.data(), _parameters.size());
+	_state = plainText;
+}
+
+void SgrRewriter::write(const char *data, const size_t length) {
+	const char *const end = data + length;
+
+	_read += length;
+	while (data < end)
+		if (_state == plainText) {
+			const char *const escape = static_cast<const char *>(std::memchr(data, '\033', end - data));
+			const char *const stop	 = escape ? escape : end;
+
+			if (stop > data) {
+				show();
+				_output.append(data, static_cast<size_t>(stop - data));
+			}
+			data = stop;
+			if (escape) {
+				_state = escapeStart;
+				++data;
+			}
+		} else if (_state == escapeStart) {
+			/* Escape sequences other than CSI are copied */
+			if (*data == '[') {
+				_parameters.clear();
+				_state = controlSequence;
+				++data;
+			} else {
+				show();
+				_output.append('\033');
+				_state = plainText;
+			}
+		} else {
+			const char *const parameters = data;
+
+			while (data < end and *data >= 0x20 and *data <= 0x3F)
+				++data;
+			_parameters.append(parameters, static_cast<size_t>(data - parameters));
+			if (_parameters.size() > maximumParameters) {
+				abandonSequence();
+				continue;
+			}
+			if (data == end)
+				break;
+
+			const char character = *data;
+
+			if (character == '\033')
+				abandonSequence();
+			else {
+				if (character == 'm' and _parameters.find_first_not_of("0123456789;") == std::string::npos) {
+					_source = ColorFormat::applyParameters(_source, _parameters.data(), _parameters.size());
+					_state	= plainText;
+				} else {
+					abandonSequence();
+					_output.append(character);
+				}
+				++data;
+			}
+		}
+}
+
+void SgrRewriter::finish(void) {
+	if (_state == escapeStart) {
+		show();
+		_output.append('\033');
+		_state = plainText;
+	} else if (_state == controlSequence)
+		abandonSequence();
+	show();
+}
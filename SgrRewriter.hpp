@@ -0,0 +1,183 @@
+#pragma once
+
+/* ############################################################################################## */
+
+/**
+ * @file SgrRewriter.hpp
+ * @brief Declaration of the SgrRewriter class, which rewrites the colors and styles of an
+ * ANSI stream as it passes.
+ *
+ * Each SGR sequence is parsed and its attributes go through a mapping: colors replaced by
+ * others (a theme swap), styles replaced by other attributes, then colors brought down to
+ * the depth of the terminal:
+ * ```
+ * BufferedWriter output(std::cout);
+ * SgrRewriter	  rewriter(output);
+ * rewriter.mapColor(ColorFormat::red, ColorFormat::rgb(230, 159, 0))	// orange for red
+ *		   .mapColor(ColorFormat::green, ColorFormat::rgb(86, 180, 233))	// sky blue for green
+ *		   .mapStyle(ColorFormat::blink, ColorFormat::bold | ColorFormat::underline)
+ *		   .depth(SgrRewriter::basicDepth);
+ * rewriter.write(log.data(), log.size());
+ * rewriter.finish();
+ * ```
+ * The text and the other escape sequences are copied unchanged. Without mappings, the
+ * rewriter minimizes the sequences of a stream, and reports the bytes it saved:
+ * ```
+ * const std::string archived = SgrRewriter::minimize(log);
+ * ```
+ *
+ * @author aheitz
+ * @date Created: 2026-10-17
+ * @date Last Modified: 2026-10-17
+ */
+
+/* ############################################################################################## */
+
+/*
+ * This file is part of the ColorFormat library.
+ *
+ * Copyright (C) 2025 aheitz <alexy.pa.heitz@gmail.com>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+/* ############################################################################################## */
+
+#include "BufferedWriter.hpp"
+#include "ColorFormat.hpp"
+
+#include <cstddef>
+#include <string>
+#include <utility>
+#include <vector>
+
+/* ############################################################################################## */
+
+/**
+ * @brief Streaming rewriter of SGR sequences.
+ *
+ * The attributes are followed from sequence to sequence, and the ones shown are written
+ * only when text comes, in a single sequence from the previous ones (see
+ * ColorFormat::writeDelta()): consecutive sequences and sequences changing nothing once
+ * mapped are not written.
+ */
+class SgrRewriter {
+	public:
+		enum ColorDepth {
+			trueColorDepth,	/**< Colors are kept */
+			paletteDepth,	/**< Truecolor colors become the nearest of the 256-color palette */
+			basicDepth,		/**< Truecolor and 256-color colors become the nearest of the 16 basic ones */
+			noColorDepth	/**< Colors are removed, styles are kept */
+		};
+
+		enum {
+			/** Longest parameter list kept for a sequence; longer ones are copied unchanged */
+			maximumParameters = 256
+		};
+
+		/** Creates a rewriter that changes nothing until mappings are given. */
+		explicit SgrRewriter(BufferedWriter &output);
+
+		/** @name Mapping */
+		/** @{ */
+		/**
+		 * @brief Replaces a color by another, on both grounds.
+		 * @param color A foreground color, such as `ColorFormat::red` or `ColorFormat::palette(208)`.
+		 * @param replacement A foreground color, or 0 to remove the color.
+		 * @throws std::invalid_argument if either holds something else than a foreground color.
+		 */
+		SgrRewriter &mapColor(ColorFormat::Attributes color, ColorFormat::Attributes replacement);
+		/**
+		 * @brief Replaces a style by other attributes, whose colors win over the ones of the text.
+		 * @throws std::invalid_argument if `style` is not a single style.
+		 */
+		SgrRewriter &mapStyle(ColorFormat::Attributes style, ColorFormat::Attributes replacement);
+		/** Sets the depth colors are brought down to, after the other mappings. */
+		SgrRewriter &depth(ColorDepth depth);
+		/** Removes the mappings and keeps the colors. */
+		SgrRewriter &clear(void);
+
+		/** Applies the mappings to a set of attributes. */
+		ColorFormat::Attributes map(ColorFormat::Attributes attributes) const;
+		/** @} */
+
+		/** Rewrites the next chunk of the stream. */
+		void write(const char *data, size_t length);
+
+		/**
+		 * @brief Writes the attributes set by the last sequences, if they differ from the ones shown.
+		 *
+		 * An escape sequence left unterminated is copied unchanged.
+		 */
+		void finish(void);
+
+		/** @name Statistics */
+		/** @{ */
+		size_t bytesRead(void) const;
+		/** Retrieves the number of bytes written since the rewriter was created, finish() included. */
+		size_t bytesWritten(void) const;
+		/** Retrieves bytesRead() minus bytesWritten(), negative if the mappings lengthened the sequences. */
+		ptrdiff_t bytesSaved(void) const;
+		/** @} */
+
+		/**
+		 * @brief Rewrites a whole text without mappings, which only minimizes its sequences.
+		 *
+		 * Redundant resets and repeated prefixes, such as the ones of consecutive formatString()
+		 * results, are dropped and consecutive sequences merged.
+		 */
+		static std::string minimize(const std::string &text);
+
+		/**
+		 * @brief Retrieves the 256-color index nearest to a 0xRRGGBB value, in the color cube or the gray ramp.
+		 */
+		static unsigned int nearestPaletteIndex(unsigned int value);
+	private:
+		enum { cacheSize = 64 };
+
+		/** Where the previous chunk stopped */
+		enum State { plainText, escapeStart, controlSequence };
+
+		struct CachedMapping {
+			ColorFormat::Attributes	from;
+			ColorFormat::Attributes	to;
+			bool					valid;
+		};
+
+		typedef std::pair<ColorFormat::Attributes, ColorFormat::Attributes> ColorMapping;
+
+		BufferedWriter				&_output;
+		std::vector<ColorMapping>	_colors;
+		ColorFormat::Attributes		_styles[ColorFormat::styleCount];	/**< Replacements of the styles */
+		ColorFormat::Attributes		_mappedStyles;
+		ColorDepth					_depth;
+		unsigned char				_paletteToBasic[256];				/**< Nearest basic color of each palette index */
+		CachedMapping				_cache[cacheSize];
+
+		State						_state;
+		std::string					_parameters;	/**< Parameters of the sequence being read */
+		ColorFormat::Attributes		_source;		/**< Attributes set by the stream */
+		ColorFormat::Attributes		_shown;			/**< Attributes written to the output */
+		size_t						_read;
+		size_t						_start;			/**< Size of the output when the rewriter was created */
+
+		ColorFormat::Attributes mapColor(ColorFormat::Attributes color) const;
+		ColorFormat::Attributes mapped(ColorFormat::Attributes attributes);
+		void invalidate(void);
+		void show(void);
+		void abandonSequence(void);
+
+		SgrRewriter(const SgrRewriter &source);
+		SgrRewriter &operator=(const SgrRewriter &source);
+};
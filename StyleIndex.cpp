@@ -0,0 +1,413 @@
+#include "StyleIndex.hpp"
+
+/* ############################################################################################## */
+
+/**
+ * @file StyleIndex.cpp
+ * @brief Implementation of the StyleIndex class.
+ *
+ * Building and searching share a parser that follows the SGR sequences of a log in chunks
+ * and reports its text with the attributes it is shown with. Files are handed to threads
+ * one at a time through an atomic counter.
+ *
+ * @author aheitz
+ * @date Created: 2026-10-17
+ * @date Last Modified: 2026-10-17
+ */
+
+/* ############################################################################################## */
+
+/*
+ * This file is part of the ColorFormat library.
+ *
+ * Copyright (C) 2025 aheitz <alexy.pa.heitz@gmail.com>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+/* ############################################################################################## */
+
+#include <atomic>
+#include <cstring>
+#include <exception>
+#include <fstream>
+#include <stdexcept>
+#include <thread>
+
+/* ############################################################################################## */
+
+namespace {
+	/** Bits of the bitmaps after the styles: basic foregrounds, basic backgrounds, then the other kinds */
+	enum {
+		basicForegroundBit	 = ColorFormat::styleCount,
+		basicBackgroundBit	 = basicForegroundBit + 16,
+		paletteForegroundBit = basicBackgroundBit + 16,
+		rgbForegroundBit,
+		paletteBackgroundBit,
+		rgbBackgroundBit
+	};
+
+	const char	 header[]		   = "CFSI\2";
+	const size_t readingSize	   = 1 << 16;
+	const size_t maximumParameters = 256;
+
+	/**
+	 * @brief Follows the attributes of a log read in chunks.
+	 *
+	 * SGR sequences change the attributes; other escape sequences are skipped.
+	 */
+	struct Parser {
+		enum State { plainText, escapeStart, controlSequence };
+
+		State					state;
+		std::string				parameters;
+		ColorFormat::Attributes	attributes;
+
+		explicit Parser(const ColorFormat::Attributes start) : state(plainText), attributes(start) {}
+
+		/** Resumes the parsing at the start of a block. */
+		explicit Parser(const StyleIndex::Block &block)
+			: state(static_cast<State>(block.sequenceState)), parameters(block.parameters), attributes(block.attributes) {}
+
+		/**
+		 * @brief Reads a chunk, giving its text to `text(const char *text, size_t length, Attributes attributes)`.
+		 */
+		template <typename Text>
+		void parse(const char *data, const size_t length, Text text) {
+			const char *const end = data + length;
+
+			while (data < end)
+				if (state == plainText) {
+					const char *const escape = static_cast<const char *>(std::memchr(data, '\033', end - data));
+					const char *const stop	 = escape ? escape : end;
+
+					if (stop > data)
+						text(data, static_cast<size_t>(stop - data), attributes);
+					data = stop;
+					if (escape) {
+						state = escapeStart;
+						++data;
+					}
+				} else if (state == escapeStart) {
+					state = *data++ == '[' ? controlSequence : plainText;
+					parameters.clear();
+				} else {
+					const char character = *data++;
+
+					if (character >= 0x20 and character <= 0x3F) {
+						parameters += character;
+						if (parameters.size() > maximumParameters)
+							state = plainText;
+						continue;
+					}
+					if (character == 'm' and parameters.find_first_not_of("0123456789;") == std::string::npos)
+						attributes = ColorFormat::applyParameters(attributes, parameters.data(), parameters.size());
+					state = plainText;
+				}
+		}
+	};
+
+	/**
+	 * @brief Tells whether attributes have all the styles of a query and its colors, if given.
+	 */
+	bool matchesQuery(const ColorFormat::Attributes attributes, const ColorFormat::Attributes query) {
+		return (attributes & query & ColorFormat::styleMask) == (query & ColorFormat::styleMask)
+			and (not (query & ColorFormat::foregroundMask) or (attributes & ColorFormat::foregroundMask) == (query & ColorFormat::foregroundMask))
+			and (not (query & ColorFormat::backgroundMask) or (attributes & ColorFormat::backgroundMask) == (query & ColorFormat::backgroundMask));
+	}
+
+	/**
+	 * @brief Calls `function(index)` for each index below `count` on several threads.
+	 *
+	 * The first exception thrown is rethrown once every thread has stopped.
+	 */
+	template <typename Function>
+	void parallelFor(const size_t count, unsigned int threads, Function function) {
+		std::atomic<size_t>		 next(0);
+		std::exception_ptr		 error;
+		std::atomic<bool>		 failed(false);
+		std::vector<std::thread> workers;
+
+		if (not threads)
+			threads = std::thread::hardware_concurrency() ? std::thread::hardware_concurrency() : 1;
+		if (threads > count)
+			threads = static_cast<unsigned int>(count);
+
+		auto work = [&]() {
+			for (size_t index = next++ ; index < count and not failed ; index = next++)
+				try {
+					function(index);
+				} catch (...) {
+					if (not failed.exchange(true))
+						error = std::current_exception();
+				}
+		};
+
+		for (unsigned int i = 1 ; i < threads ; i++)
+			workers.emplace_back(work);
+		work();
+		for (std::thread &worker : workers)
+			worker.join();
+		if (error)
+			std::rethrow_exception(error);
+	}
+
+	void writeNumber(std::ostream &output, const uint64_t value) {
+		char bytes[8];
+
+		for (size_t i = 0 ; i < 8 ; i++)
+			bytes[i] = static_cast<char>(value >> i * 8);
+		output.write(bytes, 8);
+	}
+
+	uint64_t readNumber(std::istream &input) {
+		unsigned char bytes[8];
+		uint64_t	  value = 0;
+
+		if (not input.read(reinterpret_cast<char *>(bytes), 8))
+			throw std::invalid_argument("❌ The saved style index is truncated.");
+		for (size_t i = 0 ; i < 8 ; i++)
+			value |= static_cast<uint64_t>(bytes[i]) << i * 8;
+		return value;
+	}
+}
+
+/* ############################################################################################## */
+
+uint64_t StyleIndex::features(const ColorFormat::Attributes attributes) {
+	static const uint64_t kindBits[2][4] = {
+		{0, 0, static_cast<uint64_t>(1) << paletteForegroundBit, static_cast<uint64_t>(1) << rgbForegroundBit},
+		{0, 0, static_cast<uint64_t>(1) << paletteBackgroundBit, static_cast<uint64_t>(1) << rgbBackgroundBit}
+	};
+	const unsigned int foregroundKind = static_cast<unsigned int>(attributes >> ColorFormat::foregroundKindShift & 3);
+	const unsigned int backgroundKind = static_cast<unsigned int>(attributes >> ColorFormat::backgroundKindShift & 3);
+	uint64_t		   bits			  = attributes & ColorFormat::styleMask;
+
+	if (foregroundKind == ColorFormat::basicColor)
+		bits |= static_cast<uint64_t>(1) << (basicForegroundBit + (attributes >> ColorFormat::foregroundShift & 15));
+	if (backgroundKind == ColorFormat::basicColor)
+		bits |= static_cast<uint64_t>(1) << (basicBackgroundBit + (attributes >> ColorFormat::backgroundShift & 15));
+	return bits | kindBits[0][foregroundKind] | kindBits[1][backgroundKind];
+}
+
+void StyleIndex::add(const std::vector<std::string> &paths, const unsigned int threads) {
+	std::vector<File> files(paths.size());
+
+	for (size_t i = 0 ; i < paths.size() ; i++)
+		files[i].path = paths[i];
+	parallelFor(files.size(), threads, [&](const size_t index) { scan(files[index]); });
+	_files.insert(_files.end(), files.begin(), files.end());
+}
+
+std::vector<StyleIndex::Match> StyleIndex::find(const ColorFormat::Attributes query, const unsigned int threads) const {
+	std::vector<std::vector<Match> > found(_files.size());
+	std::vector<Match>				 matches;
+
+	parallelFor(_files.size(), threads, [&](const size_t index) { search(_files[index], index, query, found[index]); });
+	for (size_t i = 0 ; i < found.size() ; i++)
+		matches.insert(matches.end(), found[i].begin(), found[i].end());
+	return matches;
+}
+
+size_t StyleIndex::candidateBlocks(const ColorFormat::Attributes query) const {
+	const uint64_t bits	 = features(query);
+	size_t		   count = 0;
+
+	for (size_t i = 0 ; i < _files.size() ; i++)
+		for (size_t j = 0 ; j < _files[i].blocks.size() ; j++)
+			count += (_files[i].blocks[j].features & bits) == bits;
+	return count;
+}
+
+size_t StyleIndex::fileCount(void) const { return _files.size(); }
+
+const std::string &StyleIndex::path(const size_t file) const { return _files.at(file).path; }
+
+const std::vector<StyleIndex::Block> &StyleIndex::blocks(const size_t file) const { return _files.at(file).blocks; }
+
+/* ############################################################################################## */
+
+/**
+ * @brief Reads a file in chunks and records its blocks.
+ *
+ * A block ends on the first line feed past blockSize bytes, or after maximumBlockSize bytes
+ * when lines are longer (or only end with carriage returns). The state of the parser is kept
+ * with the block, so that it can be parsed on its own even when it starts inside a sequence.
+ */
+void StyleIndex::scan(File &file) {
+	std::ifstream	  input(file.path.c_str(), std::ios::binary);
+	std::vector<char> chunk(readingSize);
+	Parser			  parser(0);
+	Block			  block = {0, 0, 0, 0, 0, std::string()};
+
+	if (not input)
+		throw std::runtime_error("❌ Cannot read " + file.path + ".");
+	file.blocks.clear();
+	while (input.read(chunk.data(), chunk.size()) or input.gcount() > 0) {
+		const size_t length	  = static_cast<size_t>(input.gcount());
+		size_t		 position = 0;
+
+		while (position < length) {
+			size_t		 end		 = length;
+			bool		 finished	 = false;
+			const size_t searchStart = block.length >= blockSize ? position : position + static_cast<size_t>(blockSize - block.length);
+
+			if (searchStart < length) {
+				const char *const lineFeed = static_cast<const char *>(std::memchr(chunk.data() + searchStart, '\n', length - searchStart));
+
+				if (lineFeed) {
+					end		 = static_cast<size_t>(lineFeed - chunk.data()) + 1;
+					finished = true;
+				}
+			}
+
+			const size_t limit = position + static_cast<size_t>(maximumBlockSize - block.length);
+
+			if (limit <= end) {
+				end		 = limit;
+				finished = true;
+			}
+			parser.parse(chunk.data() + position, end - position, [&](const char *, size_t, const ColorFormat::Attributes attributes) {
+				block.features |= features(attributes);
+			});
+			block.length += end - position;
+			position	  = end;
+			if (finished) {
+				file.blocks.push_back(block);
+				block.offset	+= block.length;
+				block.length	 = 0;
+				block.attributes	= parser.attributes;
+				block.features		= 0;
+				block.sequenceState = parser.state;
+				block.parameters	= parser.state == Parser::controlSequence ? parser.parameters : std::string();
+			}
+		}
+	}
+	if (block.length)
+		file.blocks.push_back(block);
+}
+
+/**
+ * @brief Reads the blocks of a file whose bitmap matches a query and collects the matching text.
+ *
+ * Text of the same attributes is joined across escape sequences that do not change them, and
+ * across the end of a block when the next one is also read, and split at line feeds.
+ */
+void StyleIndex::search(const File &file, const size_t index, const ColorFormat::Attributes query, std::vector<Match> &matches) {
+	const uint64_t	  bits = features(query);
+	std::ifstream	  input;
+	std::vector<char> data;
+	bool			  open = false;	/* Whether the last match can go on */
+
+	for (size_t i = 0 ; i < file.blocks.size() ; i++) {
+		const Block &block = file.blocks[i];
+
+		if ((block.features & bits) != bits) {
+			open = false;
+			continue;
+		}
+		if (not input.is_open()) {
+			input.open(file.path.c_str(), std::ios::binary);
+			if (not input)
+				throw std::runtime_error("❌ Cannot read " + file.path + ".");
+		}
+		data.resize(static_cast<size_t>(block.length));
+		input.seekg(static_cast<std::streamoff>(block.offset));
+		if (not input.read(data.data(), static_cast<std::streamsize>(block.length)))
+			throw std::runtime_error("❌ " + file.path + " changed since it was indexed.");
+
+		Parser parser(block);
+
+		parser.parse(data.data(), data.size(), [&](const char *text, size_t length, const ColorFormat::Attributes attributes) {
+			if (not matchesQuery(attributes, query)) {
+				open = false;
+				return;
+			}
+			while (length) {
+				const char *const lineFeed = static_cast<const char *>(std::memchr(text, '\n', length));
+				const size_t	  taken	   = lineFeed ? static_cast<size_t>(lineFeed - text) : length;
+
+				if (taken) {
+					if (open and matches.back().attributes == attributes)
+						matches.back().text.append(text, taken);
+					else {
+						const Match match = {index, block.offset + static_cast<uint64_t>(text - data.data()), std::string(text, taken), attributes};
+
+						matches.push_back(match);
+					}
+				}
+				open	= not lineFeed;
+				text   += taken;
+				length -= taken;
+				if (lineFeed) {
+					++text;
+					--length;
+				}
+			}
+		});
+	}
+}
+
+/* ############################################################################################## */
+
+void StyleIndex::save(std::ostream &output) const {
+	output.write(header, sizeof(header) - 1);
+	writeNumber(output, _files.size());
+	for (size_t i = 0 ; i < _files.size() ; i++) {
+		writeNumber(output, _files[i].path.size());
+		output.write(_files[i].path.data(), static_cast<std::streamsize>(_files[i].path.size()));
+		writeNumber(output, _files[i].blocks.size());
+		for (size_t j = 0 ; j < _files[i].blocks.size() ; j++) {
+			writeNumber(output, _files[i].blocks[j].offset);
+			writeNumber(output, _files[i].blocks[j].length);
+			writeNumber(output, _files[i].blocks[j].attributes);
+			writeNumber(output, _files[i].blocks[j].features);
+			writeNumber(output, _files[i].blocks[j].sequenceState);
+			writeNumber(output, _files[i].blocks[j].parameters.size());
+			output.write(_files[i].blocks[j].parameters.data(), static_cast<std::streamsize>(_files[i].blocks[j].parameters.size()));
+		}
+	}
+}
+
+void StyleIndex::load(std::istream &input) {
+	char			  start[sizeof(header) - 1];
+	std::vector<File> files;
+
+	if (not input.read(start, sizeof(start)) or std::memcmp(start, header, sizeof(start)))
+		throw std::invalid_argument("❌ The data is not a saved style index.");
+	files.resize(static_cast<size_t>(readNumber(input)));
+	for (size_t i = 0 ; i < files.size() ; i++) {
+		files[i].path.resize(static_cast<size_t>(readNumber(input)));
+		if (not input.read(&files[i].path[0], static_cast<std::streamsize>(files[i].path.size())))
+			throw std::invalid_argument("❌ The saved style index is truncated.");
+		files[i].blocks.resize(static_cast<size_t>(readNumber(input)));
+		for (size_t j = 0 ; j < files[i].blocks.size() ; j++) {
+			files[i].blocks[j].offset	  = readNumber(input);
+			files[i].blocks[j].length	  = readNumber(input);
+			files[i].blocks[j].attributes = readNumber(input);
+			files[i].blocks[j].features	  = readNumber(input);
+
+			const uint64_t state  = readNumber(input);
+			const uint64_t length = readNumber(input);
+
+			if (state > 2 or length > maximumParameters)
+				throw std::invalid_argument("❌ The data is not a saved style index.");
+			files[i].blocks[j].sequenceState = static_cast<unsigned int>(state);
+			files[i].blocks[j].parameters.resize(static_cast<size_t>(length));
+			if (length and not input.read(&files[i].blocks[j].parameters[0], static_cast<std::streamsize>(length)))
+				throw std::invalid_argument("❌ The saved style index is truncated.");
+		}
+	}
+	_files.insert(_files.end(), files.begin(), files.end());
+}
@@ -0,0 +1,149 @@
+#pragma once
+
+/* ############################################################################################## */
+
+/**
+ * @file StyleIndex.hpp
+ * @brief Declaration of the StyleIndex class, which finds styled text in colored log files.
+ *
+ * The logs are scanned once; each block of about 64 KiB keeps a bitmap of the styles and
+ * colors shown in it, so a search only reads the blocks that can hold a match:
+ * ```
+ * StyleIndex index;
+ * index.add({"app-1.log", "app-2.log", "app-3.log"});
+ *
+ * // The out of range numbers of formatGradientUnsignedInteger(), red or green
+ * for (const StyleIndex::Match &match : index.find(ColorFormat::blink | ColorFormat::bold))
+ *     std::cout << index.path(match.file) << ':' << match.offset << ' ' << match.text << '\n';
+ * ```
+ * The 16 basic colors each have their own bit; 256-color and truecolor ones share a bit per
+ * kind and ground, their exact value being checked when the block is read.
+ *
+ * Requires C++11.
+ *
+ * @author aheitz
+ * @date Created: 2026-10-17
+ * @date Last Modified: 2026-10-17
+ */
+
+/* ############################################################################################## */
+
+/*
+ * This file is part of the ColorFormat library.
+ *
+ * Copyright (C) 2025 aheitz <alexy.pa.heitz@gmail.com>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+/* ############################################################################################## */
+
+#include "ColorFormat.hpp"
+
+#include <istream>
+#include <ostream>
+#include <string>
+#include <vector>
+
+/* ############################################################################################## */
+
+/**
+ * @brief Index of the styles shown in a set of colored log files.
+ *
+ * Files are read in chunks, several at once, and are not kept in memory.
+ */
+class StyleIndex {
+	public:
+		enum {
+			/** Bytes after which a block ends on the next line feed */
+			blockSize		 = 64 << 10,
+			/** Bytes after which a block ends even without a line feed */
+			maximumBlockSize = 1 << 20
+		};
+
+		/** Part of a file, which can be read on its own. */
+		struct Block {
+			uint64_t				offset;
+			uint64_t				length;
+			ColorFormat::Attributes	attributes;	/**< Attributes of the terminal at the start of the block */
+			uint64_t				features;	/**< Bitmap of the styles and colors shown in the block */
+			/**
+			 * Escape sequence open at the start of a block cut inside a line: 0 if none, 1 after
+			 * its escape character, 2 inside a control sequence whose parameters read so far
+			 * are `parameters`.
+			 */
+			unsigned int			sequenceState;
+			std::string				parameters;
+		};
+
+		/** Text shown with the searched attributes, up to the end of its line. */
+		struct Match {
+			size_t					file;
+			uint64_t				offset;		/**< Offset of the text in the file, escape sequences included */
+			std::string				text;
+			ColorFormat::Attributes	attributes;
+		};
+
+		/**
+		 * @brief Indexes files, scanned in parallel.
+		 * @param threads The number of threads, one per core if 0.
+		 * @throws std::runtime_error if a file cannot be read.
+		 */
+		void add(const std::vector<std::string> &paths, unsigned int threads = 0);
+
+		/**
+		 * @brief Finds the text shown with attributes, reading only the blocks whose bitmap matches.
+		 *
+		 * Text matches when it has all the styles of the query and its colors, if given.
+		 * The files are searched in parallel; matches are returned in file order.
+		 *
+		 * @throws std::runtime_error if a file cannot be read.
+		 */
+		std::vector<Match> find(ColorFormat::Attributes query, unsigned int threads = 0) const;
+
+		/** Retrieves the number of blocks whose bitmap matches a query, over all the files. */
+		size_t candidateBlocks(ColorFormat::Attributes query) const;
+
+		/**
+		 * @brief Converts attributes to the bits they set in the bitmap of a block.
+		 */
+		static uint64_t features(ColorFormat::Attributes attributes);
+
+		/** @name Indexed files */
+		/** @{ */
+		size_t fileCount(void) const;
+		const std::string &path(size_t file) const;
+		const std::vector<Block> &blocks(size_t file) const;
+		/** @} */
+
+		/** @name Storage of the index, so that files are scanned only once */
+		/** @{ */
+		void save(std::ostream &output) const;
+		/**
+		 * @brief Adds the files of a saved index.
+		 * @throws std::invalid_argument if the data is not a saved index.
+		 */
+		void load(std::istream &input);
+		/** @} */
+	private:
+		struct File {
+			std::string			path;
+			std::vector<Block>	blocks;
+		};
+
+		std::vector<File> _files;
+
+		static void scan(File &file);
+		static void search(const File &file, size_t index, ColorFormat::Attributes query, std::vector<Match> &matches);
+};
@@ -0,0 +1,191 @@
+#pragma once
+
+/* ############################################################################################## */
+
+/**
+ * @file StyleStack.hpp
+ * @brief Declaration of the StyleStack class, which nests styles instead of stripping them.
+ *
+ * formatString() strips the formats of the text it wraps, so a bold number loses its
+ * style inside a red sentence. A StyleStack keeps the styles of the enclosing spans and,
+ * when an inner span ends, only writes what differs from the outer one:
+ * ```
+ * std::string    line;
+ * StyleStack     styles;
+ * styles.push(line, ColorFormat::red);
+ * styles.append(line, "disk ");
+ * styles.push(line, ColorFormat::bold);
+ * styles.append(line, "full");
+ * styles.pop(line);                    // writes \033[22m, the text stays red
+ * styles.append(line, ColorFormat::formatString("95%", "underline"));
+ * styles.close(line);
+ * ```
+ * Text appended to the stack may hold escape sequences of its own: a reset inside it
+ * restores the style of the enclosing spans rather than the default one.
+ *
+ * @author aheitz
+ * @date Created: 2026-10-17
+ * @date Last Modified: 2026-10-17
+ */
+
+/* ############################################################################################## */
+
+/*
+ * This file is part of the ColorFormat library.
+ *
+ * Copyright (C) 2025 aheitz <alexy.pa.heitz@gmail.com>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+/* ############################################################################################## */
+
+#include "ColorFormat.hpp"
+
+#include <cstring>
+#include <stdexcept>
+#include <string>
+
+/* ############################################################################################## */
+
+/**
+ * @brief Stack of nested styles, in a fixed array.
+ *
+ * Every operation writes at most one escape sequence (see ColorFormat::writeDelta()) and
+ * takes constant time, apart from copying appended text. The output can be any type with
+ * `append(const char *, size_t)`: std::string, InlineString, BufferedWriter...
+ */
+class StyleStack {
+	public:
+		/** Deepest nesting of spans. */
+		enum { maximumDepth = 16 };
+
+		StyleStack(void) : _depth(0), _terminal(0) { _styles[0] = 0; }
+
+		/**
+		 * @brief Opens a span: applies formats over the current ones (see ColorFormat::overlay()).
+		 * @throws std::length_error if maximumDepth spans are already open.
+		 */
+		template <typename String>
+		void push(String &output, ColorFormat::Attributes attributes);
+
+		/**
+		 * @brief Closes the innermost span, restoring the style of the enclosing one.
+		 * @throws std::invalid_argument if no span is open.
+		 */
+		template <typename String>
+		void pop(String &output);
+
+		/** @name Text in the current style */
+		/** @{ */
+		template <typename String>
+		void append(String &output, const char *text, size_t length);
+		template <typename String>
+		void append(String &output, const std::string &text);
+		/** @} */
+
+		/** Closes every span and resets the terminal. */
+		template <typename String>
+		void close(String &output);
+
+		/** Retrieves the style of the innermost span. */
+		ColorFormat::Attributes current(void) const { return _styles[_depth]; }
+
+		size_t depth(void) const { return _depth; }
+	private:
+		ColorFormat::Attributes	_styles[maximumDepth + 1];	/**< Style of each open span, after the default one */
+		size_t					_depth;
+		ColorFormat::Attributes	_terminal;					/**< Style shown by the terminal, as left by the appended text */
+
+		template <typename String>
+		void switchTo(String &output, ColorFormat::Attributes attributes);
+};
+
+/* ############################################################################################## */
+
+template <typename String>
+void StyleStack::switchTo(String &output, const ColorFormat::Attributes attributes) {
+	char delta[ColorFormat::deltaCapacity];
+
+	output.append(delta, ColorFormat::writeDelta(_terminal, attributes, delta));
+	_terminal = attributes;
+}
+
+template <typename String>
+void StyleStack::push(String &output, const ColorFormat::Attributes attributes) {
+	if (_depth == maximumDepth)
+		throw std::length_error("❌ Styles are nested too deeply.");
+	_styles[_depth + 1] = ColorFormat::overlay(_styles[_depth], attributes);
+	++_depth;
+	switchTo(output, _styles[_depth]);
+}
+
+template <typename String>
+void StyleStack::pop(String &output) {
+	if (!_depth)
+		throw std::invalid_argument("❌ No style to pop.");
+	--_depth;
+	switchTo(output, _styles[_depth]);
+}
+
+template <typename String>
+void StyleStack::close(String &output) {
+	_depth = 0;
+	switchTo(output, 0);
+}
+
+template <typename String>
+void StyleStack::append(String &output, const std::string &text) {
+	append(output, text.data(), text.size());
+}
+
+template <typename String>
+void StyleStack::append(String &output, const char *text, const size_t length) {
+	const char *position = text;
+	const char *end		 = text + length;
+
+	if (_terminal != _styles[_depth])
+		switchTo(output, _styles[_depth]);
+	while (position < end) {
+		const char *escape = static_cast<const char *>(std::memchr(position, '\033', static_cast<size_t>(end - position)));
+		if (!escape or escape + 1 == end or escape[1] != '[') {
+			const char *copied = escape ? escape + 1 : end;
+			output.append(position, static_cast<size_t>(copied - position));
+			position = copied;
+			continue;
+		}
+
+		/* Control sequence: parameters, then a final byte from '@' to '~' */
+		const char *final = escape + 2;
+		bool		sgr	  = true;
+		while (final < end and (*final < '@' or *final > '~')) {
+			sgr = sgr and ((*final >= '0' and *final <= '9') or *final == ';');
+			++final;
+		}
+		output.append(position, static_cast<size_t>(escape - position));
+		if (final == end) {
+			output.append(escape, static_cast<size_t>(end - escape));
+			return;
+		}
+		if (!sgr or *final != 'm') {
+			output.append(escape, static_cast<size_t>(final + 1 - escape));
+			position = final + 1;
+			continue;
+		}
+
+		/* A reset restores the style of the enclosing spans */
+		switchTo(output, ColorFormat::applyParameters(_terminal, escape + 2, static_cast<size_t>(final - escape - 2), _styles[_depth]));
+		position = final + 1;
+	}
+}
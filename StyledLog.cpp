@@ -0,0 +1,486 @@
+#include "StyledLog.hpp"
+
+/* ############################################################################################## */
+
+/**
+ * @file StyledLog.cpp
+ * @brief Implementation of the StyledLogEncoder and StyledLogReader classes.
+ *
+ * The encoder copies the text between escape sequences in bulk and only looks at the
+ * sequences themselves; the reader returns runs pointing into the log, so neither copies
+ * the text more than once.
+ *
+ * @author aheitz
+ * @date Created: 2026-10-17
+ * @date Last Modified: 2026-10-17
+ */
+
+/* ############################################################################################## */
+
+/*
+ * This file is part of the ColorFormat library.
+ *
+ * Copyright (C) 2025 aheitz <alexy.pa.heitz@gmail.com>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+/* ############################################################################################## */
+
+#include <cstring>
+#include <stdexcept>
+
+/* ############################################################################################## */
+
+static const char	header[]	 = "CFSL\1";
+static const size_t headerLength = sizeof(header) - 1;
+
+/** Longest opening tag written by writeSpan() */
+static const size_t spanCapacity = 256;
+
+/**
+ * @brief Appends an unsigned LEB128 number.
+ */
+static void appendNumber(std::string &output, uint64_t value) {
+	char   bytes[10];
+	size_t length = 0;
+
+	while (value >= 0x80) {
+		bytes[length++] = static_cast<char>((value & 0x7F) | 0x80);
+		value		  >>= 7;
+	}
+	bytes[length++] = static_cast<char>(value);
+	output.append(bytes, length);
+}
+
+/* ############################################################################################## */
+
+StyledLogEncoder::StyledLogEncoder(BufferedWriter &output)
+	: _output(output), _state(plainText), _attributes(0), _runAttributes(0), _runLength(0), _lastStyle(0) {
+	_output.append(header, headerLength);
+}
+
+void StyledLogEncoder::write(const char *data, const size_t length) {
+	const char *const end = data + length;
+
+	while (data < end)
+		if (_state == plainText) {
+			const char *const escape = static_cast<const char *>(std::memchr(data, '\033', end - data));
+			const char *const stop	 = escape ? escape : end;
+
+			appendText(data, stop - data);
+			data = stop;
+			if (escape) {
+				_state = escapeStart;
+				++data;
+			}
+		} else if (_state == escapeStart) {
+			/* Escape sequences other than CSI are kept in the text */
+			if (*data == '[') {
+				_parameters.clear();
+				_state = controlSequence;
+				++data;
+			} else {
+				appendText("\033", 1);
+				_state = plainText;
+			}
+		} else {
+			const char character = *data;
+
+			if (character >= 0x20 and character <= 0x3F) {
+				_parameters += character;
+				++data;
+				if (_parameters.size() > maximumParameters)
+					abandonSequence();
+			} else if (character == '\033')
+				_state = plainText;		/* Dropped as the terminal does, as its "\033[" could form a sequence with the text stored after it */
+			else {
+				if (character == 'm' and _parameters.find_first_not_of("0123456789;") == std::string::npos) {
+					_attributes = ColorFormat::applyParameters(_attributes, _parameters.data(), _parameters.size());
+					_state		= plainText;
+				} else {
+					abandonSequence();
+					appendText(&character, 1);
+				}
+				++data;
+			}
+		}
+}
+
+void StyledLogEncoder::finish(void) {
+	if (_state == escapeStart) {
+		appendText("\033", 1);
+		_state = plainText;
+	} else if (_state == controlSequence)
+		abandonSequence();
+	if (not _text.empty())
+		endBlock();
+	_output.append('\0');
+}
+
+void StyledLogEncoder::encode(std::istream &input, std::ostream &output) {
+	BufferedWriter	 writer(output);
+	StyledLogEncoder encoder(writer);
+	char			 chunk[1 << 16];
+
+	while (input.read(chunk, sizeof(chunk)) or input.gcount() > 0)
+		encoder.write(chunk, static_cast<size_t>(input.gcount()));
+	encoder.finish();
+}
+
+/* ############################################################################################## */
+
+/**
+ * @brief Stores the sequence being read as text, as it is not one that sets attributes.
+ */
+void StyledLogEncoder::abandonSequence(void) {
+	_state = plainText;
+	appendText("\033[", 2);
+	appendText(_parameters.data(), _parameters.size());
+}
+
+/**
+ * @brief Adds text to the current run, starting a new run if the attributes changed and
+ * ending the block once it is full.
+ */
+void StyledLogEncoder::appendText(const char *text, size_t length) {
+	while (length) {
+		if (_runAttributes != _attributes) {
+			closeRun();
+			_runAttributes = _attributes;
+		}
+
+		/* The block ends on the first line feed found past blockSize bytes */
+		size_t		 taken		 = length;
+		bool		 full		 = false;
+		const size_t searchStart = _text.size() + 1 >= blockSize ? 0 : blockSize - 1 - _text.size();
+
+		if (searchStart < length) {
+			const char *const lineFeed = static_cast<const char *>(std::memchr(text + searchStart, '\n', length - searchStart));
+
+			if (lineFeed) {
+				taken = static_cast<size_t>(lineFeed - text) + 1;
+				full  = true;
+			}
+		}
+		if (_text.size() + taken >= maximumBlockSize) {
+			taken = maximumBlockSize - _text.size();
+			full  = true;
+		}
+		_text.append(text, taken);
+		_runLength += taken;
+		text	   += taken;
+		length	   -= taken;
+		if (full)
+			endBlock();
+	}
+}
+
+/**
+ * @brief Writes the current run, defining its attributes in the block if they are new.
+ */
+void StyledLogEncoder::closeRun(void) {
+	if (not _runLength)
+		return;
+	appendNumber(_runs, _runLength);
+	_runLength = 0;
+	if (_lastStyle < _styles.size() and _styles[_lastStyle] == _runAttributes) {
+		appendNumber(_runs, _lastStyle);
+		return;
+	}
+	for (size_t i = 0 ; i < _styles.size() ; i++)
+		if (_styles[i] == _runAttributes) {
+			appendNumber(_runs, i);
+			_lastStyle = i;
+			return;
+		}
+	appendNumber(_runs, _styles.size());
+	appendNumber(_runs, _runAttributes);
+	if (_styles.size() < maximumStyles) {
+		_lastStyle = _styles.size();
+		_styles.push_back(_runAttributes);
+	}
+}
+
+/**
+ * @brief Writes the current block; the next one starts with no attributes defined.
+ */
+void StyledLogEncoder::endBlock(void) {
+	std::string lengths;
+
+	closeRun();
+	appendNumber(lengths, _text.size());
+	appendNumber(lengths, _runs.size());
+	_output.append(lengths.data(), lengths.size());
+	_output.append(_text.data(), _text.size());
+	_output.append(_runs.data(), _runs.size());
+	_text.clear();
+	_runs.clear();
+	_styles.clear();
+	_lastStyle = 0;
+}
+
+/* ############################################################################################## */
+
+StyledLogReader::StyledLogReader(const char *data, const size_t length)
+	: _position(data), _end(data + length), _text(data), _textEnd(data), _runs(data), _runsEnd(data),
+	  _blockText(data), _blockOffset(0), _finished(false) {
+	if (length < headerLength or std::memcmp(data, header, headerLength - 1))
+		throw std::invalid_argument("❌ The data is not a styled log.");
+	if (data[headerLength - 1] != header[headerLength - 1])
+		throw std::invalid_argument("❌ Unsupported version of the styled log format.");
+	_position += headerLength;
+}
+
+const char *StyledLogReader::blockText(void) const { return _blockText; }
+
+size_t StyledLogReader::blockLength(void) const { return static_cast<size_t>(_textEnd - _blockText); }
+
+size_t StyledLogReader::blockOffset(void) const { return _blockOffset; }
+
+/**
+ * @brief Reads an unsigned LEB128 number.
+ * @throws std::invalid_argument if the number is truncated or too long.
+ */
+uint64_t StyledLogReader::readNumber(const char *&position, const char *const end) {
+	uint64_t value = 0;
+
+	for (unsigned int shift = 0 ; shift < 64 ; shift += 7) {
+		if (position == end)
+			throw std::invalid_argument("❌ The styled log is truncated.");
+
+		const unsigned char byte = static_cast<unsigned char>(*position++);
+
+		value |= static_cast<uint64_t>(byte & 0x7F) << shift;
+		if (not (byte & 0x80))
+			return value;
+	}
+	throw std::invalid_argument("❌ The styled log holds a number that is too long.");
+}
+
+bool StyledLogReader::nextBlock(void) {
+	if (_finished)
+		return false;
+	_blockOffset += blockLength();
+
+	const uint64_t textLength = readNumber(_position, _end);
+
+	if (not textLength) {
+		_blockText = _text = _textEnd = _runs = _runsEnd = _position;
+		_finished  = true;
+		return false;
+	}
+
+	const uint64_t runsLength = readNumber(_position, _end);
+
+	if (textLength > static_cast<uint64_t>(_end - _position) or runsLength > static_cast<uint64_t>(_end - _position) - textLength)
+		throw std::invalid_argument("❌ The styled log is truncated.");
+	_blockText = _text = _position;
+	_textEnd   = _text + textLength;
+	_runs	   = _textEnd;
+	_runsEnd   = _runs + runsLength;
+	_position  = _runsEnd;
+	_styles.clear();
+	return true;
+}
+
+bool StyledLogReader::next(Run &run) {
+	while (_runs == _runsEnd) {
+		if (_text != _textEnd)
+			throw std::invalid_argument("❌ The runs of the styled log do not cover its text.");
+		if (not nextBlock())
+			return false;
+	}
+
+	const uint64_t length = readNumber(_runs, _runsEnd);
+	const uint64_t tag	  = readNumber(_runs, _runsEnd);
+
+	if (tag < _styles.size())
+		run.attributes = _styles[tag];
+	else if (tag == _styles.size()) {
+		run.attributes = readNumber(_runs, _runsEnd);
+		if (_styles.size() < StyledLogEncoder::maximumStyles)
+			_styles.push_back(run.attributes);
+	} else
+		throw std::invalid_argument("❌ The styled log refers to undefined attributes.");
+	if (not length or length > static_cast<uint64_t>(_textEnd - _text))
+		throw std::invalid_argument("❌ The runs of the styled log do not cover its text.");
+	run.text   = _text;
+	run.length = static_cast<size_t>(length);
+	_text	  += length;
+	return true;
+}
+
+/* ############################################################################################## */
+
+void StyledLogReader::writeAnsi(BufferedWriter &output) {
+	ColorFormat::Attributes terminal = 0;
+	Run						run;
+
+	while (next(run)) {
+		if (run.attributes != terminal) {
+			output.advance(ColorFormat::writeDelta(terminal, run.attributes, output.acquire(ColorFormat::deltaCapacity)));
+			terminal = run.attributes;
+		}
+		output.append(run.text, run.length);
+	}
+	if (terminal)
+		output.append("\033[0m", 4);
+}
+
+/**
+ * @brief Writes a color as a CSS hexadecimal value.
+ * @return The end of the written value.
+ */
+static char *writeCssColor(char *position, const unsigned int value) {
+	static const char digits[] = "0123456789abcdef";
+
+	*position++ = '#';
+	for (int shift = 20 ; shift >= 0 ; shift -= 4)
+		*position++ = digits[value >> shift & 0xF];
+	return position;
+}
+
+/**
+ * @brief Writes the opening tag of a span showing a set of attributes.
+ * @param position The destination, of at least spanCapacity bytes.
+ * @return The end of the written tag.
+ */
+static char *writeSpan(char *position, const ColorFormat::Attributes attributes) {
+	const bool hasForeground   = attributes & ColorFormat::foregroundMask;
+	const bool hasBackground   = attributes & ColorFormat::backgroundMask;
+	const bool inverse		   = attributes & ColorFormat::inverse;
+	const char *decorations[4];
+	size_t	   decorationCount = 0;
+
+	std::memcpy(position, "<span style=\"", 13);
+	position += 13;
+
+	/* Inverse text swaps the colors, the ones of the page standing in for missing colors */
+	if (hasForeground or inverse) {
+		std::memcpy(position, "color:", 6);
+		position += 6;
+		if (not inverse)
+			position = writeCssColor(position, ColorFormat::colorValue(attributes));
+		else if (hasBackground)
+			position = writeCssColor(position, ColorFormat::colorValue(ColorFormat::foreground(attributes & ColorFormat::backgroundMask)));
+		else {
+			std::memcpy(position, "Canvas", 6);
+			position += 6;
+		}
+		*position++ = ';';
+	}
+	if (hasBackground or inverse) {
+		std::memcpy(position, "background-color:", 17);
+		position += 17;
+		if (not inverse)
+			position = writeCssColor(position, ColorFormat::colorValue(ColorFormat::foreground(attributes & ColorFormat::backgroundMask)));
+		else if (hasForeground)
+			position = writeCssColor(position, ColorFormat::colorValue(attributes));
+		else {
+			std::memcpy(position, "CanvasText", 10);
+			position += 10;
+		}
+		*position++ = ';';
+	}
+	if (attributes & ColorFormat::bold) {
+		std::memcpy(position, "font-weight:bold;", 17);
+		position += 17;
+	}
+	if (attributes & ColorFormat::dim) {
+		std::memcpy(position, "opacity:0.5;", 12);
+		position += 12;
+	}
+	if (attributes & ColorFormat::italic) {
+		std::memcpy(position, "font-style:italic;", 18);
+		position += 18;
+	}
+	if (attributes & ColorFormat::hidden) {
+		std::memcpy(position, "visibility:hidden;", 18);
+		position += 18;
+	}
+	if (attributes & (ColorFormat::underline | ColorFormat::doubleUnderline))
+		decorations[decorationCount++] = "underline";
+	if (attributes & ColorFormat::strikethrough)
+		decorations[decorationCount++] = "line-through";
+	if (attributes & ColorFormat::overline)
+		decorations[decorationCount++] = "overline";
+	if (attributes & ColorFormat::blink)
+		decorations[decorationCount++] = "blink";
+	if (decorationCount) {
+		std::memcpy(position, "text-decoration:", 16);
+		position += 16;
+		for (size_t i = 0 ; i < decorationCount ; i++) {
+			const size_t length = std::strlen(decorations[i]);
+
+			if (i)
+				*position++ = ' ';
+			std::memcpy(position, decorations[i], length);
+			position += length;
+		}
+		if (attributes & ColorFormat::doubleUnderline) {
+			std::memcpy(position, " double", 7);
+			position += 7;
+		}
+		*position++ = ';';
+	}
+	std::memcpy(position, "\">", 2);
+	return position + 2;
+}
+
+/**
+ * @brief Writes text with the characters HTML reserves replaced by entities.
+ */
+static void writeHtmlText(const char *text, const size_t length, BufferedWriter &output) {
+	const char *const end	= text + length;
+	const char		  *run	= text;
+
+	for (const char *position = text ; position < end ; position++) {
+		const char *entity;
+		size_t		entityLength;
+
+		switch (*position) {
+			case '&': entity = "&amp;"; entityLength = 5; break;
+			case '<': entity = "&lt;";	entityLength = 4; break;
+			case '>': entity = "&gt;";	entityLength = 4; break;
+			default:  continue;
+		}
+		output.append(run, static_cast<size_t>(position - run));
+		output.append(entity, entityLength);
+		run = position + 1;
+	}
+	output.append(run, static_cast<size_t>(end - run));
+}
+
+void StyledLogReader::writeHtml(BufferedWriter &output) {
+	ColorFormat::Attributes current = 0;
+	Run						run;
+
+	while (next(run)) {
+		/* Runs of the same attributes meet at block boundaries and share their span */
+		if (run.attributes != current) {
+			if (current)
+				output.append("</span>", 7);
+			if (run.attributes) {
+				char *const span = output.acquire(spanCapacity);
+
+				output.advance(static_cast<size_t>(writeSpan(span, run.attributes) - span));
+			}
+			current = run.attributes;
+		}
+		writeHtmlText(run.text, run.length, output);
+	}
+	if (current)
+		output.append("</span>", 7);
+}
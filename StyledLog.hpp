@@ -0,0 +1,209 @@
+#pragma once
+
+/* ############################################################################################## */
+
+/**
+ * @file StyledLog.hpp
+ * @brief Declaration of the StyledLogEncoder and StyledLogReader classes, which store colored
+ * logs as plain text and a stream of attribute runs.
+ *
+ * Escape sequences take a large share of colored logs (rainbow() writes five bytes before
+ * each character), and stripping them loses the colors. The styled log format keeps the
+ * text apart from the attributes, each run of equally styled text taking a few bytes:
+ * ```
+ * std::string		 stored;
+ * BufferedWriter	 output(stored);
+ * StyledLogEncoder encoder(output);
+ * encoder.write(coloredLog.data(), coloredLog.size());
+ * encoder.finish();
+ * output.flush();
+ *
+ * BufferedWriter  terminal(std::cout);
+ * StyledLogReader reader(stored.data(), stored.size());
+ * reader.writeAnsi(terminal);
+ * ```
+ * Layout of the format, whose integers are unsigned LEB128 varints:
+ * - the header `CFSL` followed by the version byte, 1;
+ * - blocks made of the length of their text, the length of their runs, the text and the runs;
+ *   a text length of 0 ends the log;
+ * - runs made of the length of their text and a style tag: a tag below the number of
+ *   attributes defined in the block refers to one of them, a tag equal to it is followed by
+ *   new attributes, defined for the rest of the block (up to maximumStyles of them).
+ *
+ * Blocks end on a line feed once they hold blockSize bytes of text, and can be decoded on
+ * their own. Only SGR sequences (`\033[...m`) become attributes; other escape sequences are
+ * kept in the text.
+ *
+ * @author aheitz
+ * @date Created: 2026-10-17
+ * @date Last Modified: 2026-10-17
+ */
+
+/* ############################################################################################## */
+
+/*
+ * This file is part of the ColorFormat library.
+ *
+ * Copyright (C) 2025 aheitz <alexy.pa.heitz@gmail.com>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+/* ############################################################################################## */
+
+#include "BufferedWriter.hpp"
+#include "ColorFormat.hpp"
+
+#include <istream>
+#include <ostream>
+#include <string>
+#include <vector>
+
+/* ############################################################################################## */
+
+/**
+ * @brief Streaming encoder of colored text into the styled log format.
+ *
+ * Escape sequences can be split across chunks. The terminal state is tracked from one
+ * sequence to the next, so the stored attributes are the ones the text was shown with.
+ * A control sequence cut short by another escape is dropped, as a terminal does.
+ */
+class StyledLogEncoder {
+	public:
+		enum {
+			/** Text after which a block ends on the next line feed */
+			blockSize			= 64 << 10,
+			/** Text after which a block ends even without a line feed */
+			maximumBlockSize	= 1 << 20,
+			/** Attributes defined per block; further ones are written out at each use */
+			maximumStyles		= 256,
+			/** Longest parameter list kept for a sequence; longer ones are stored as text */
+			maximumParameters	= 256
+		};
+
+		/** Writes the header of the log. */
+		explicit StyledLogEncoder(BufferedWriter &output);
+
+		/** Encodes the next chunk of colored text. */
+		void write(const char *data, size_t length);
+
+		/**
+		 * @brief Writes the last block and the end of the log.
+		 *
+		 * An escape sequence left unterminated is stored as text.
+		 */
+		void finish(void);
+
+		/**
+		 * @brief Encodes a whole stream, read in chunks.
+		 */
+		static void encode(std::istream &input, std::ostream &output);
+	private:
+		/** Where the previous chunk stopped */
+		enum State { plainText, escapeStart, controlSequence };
+
+		BufferedWriter							&_output;
+		State									_state;
+		std::string								_parameters;	/**< Parameters of the sequence being read */
+		ColorFormat::Attributes					_attributes;	/**< Attributes of the terminal */
+		ColorFormat::Attributes					_runAttributes;
+		size_t									_runLength;
+		std::string								_text;			/**< Text of the current block */
+		std::string								_runs;			/**< Runs of the current block */
+		std::vector<ColorFormat::Attributes>	_styles;		/**< Attributes defined in the current block */
+		size_t									_lastStyle;		/**< Tag of the last run */
+
+		void appendText(const char *text, size_t length);
+		void abandonSequence(void);
+		void closeRun(void);
+		void endBlock(void);
+
+		StyledLogEncoder(const StyledLogEncoder &source);
+		StyledLogEncoder &operator=(const StyledLogEncoder &source);
+};
+
+/**
+ * @brief Sequential reader of a styled log held in memory.
+ *
+ * The runs are returned in order, their text pointing into the log.
+ */
+class StyledLogReader {
+	public:
+		struct Run {
+			const char				*text;
+			size_t					length;
+			ColorFormat::Attributes	attributes;
+		};
+
+		/**
+		 * @brief Checks the header of a log.
+		 * @throws std::invalid_argument if the data is not a styled log of a supported version.
+		 */
+		StyledLogReader(const char *data, size_t length);
+
+		/**
+		 * @brief Reads the next run.
+		 * @return false at the end of the log.
+		 * @throws std::invalid_argument if the log is truncated or corrupted.
+		 */
+		bool next(Run &run);
+
+		/**
+		 * @brief Skips the runs left in the current block and moves to the next one.
+		 *
+		 * The runs of the new block are then returned by next().
+		 *
+		 * @return false at the end of the log.
+		 * @throws std::invalid_argument if the log is truncated or corrupted.
+		 */
+		bool nextBlock(void);
+
+		/** @name Current block, after next() or nextBlock() */
+		/** @{ */
+		const char *blockText(void) const;
+		size_t blockLength(void) const;
+		/** Retrieves the offset of the block text in the plain text of the whole log. */
+		size_t blockOffset(void) const;
+		/** @} */
+
+		/** @name Decoding of the remaining runs */
+		/** @{ */
+		/**
+		 * @brief Writes the text with escape sequences, a single one between two runs.
+		 *
+		 * The sequences are the shortest ones from run to run (see ColorFormat::writeDelta()),
+		 * so they can differ from the encoded ones while showing the same output.
+		 */
+		void writeAnsi(BufferedWriter &output);
+		/**
+		 * @brief Writes the text as HTML, each styled run in a `<span>` with inline CSS.
+		 *
+		 * Only the spans are written; place them in a `<pre>` element to keep the lines.
+		 */
+		void writeHtml(BufferedWriter &output);
+		/** @} */
+	private:
+		const char								*_position;
+		const char								*_end;
+		const char								*_text;			/**< Next text of the block */
+		const char								*_textEnd;
+		const char								*_runs;			/**< Next run of the block */
+		const char								*_runsEnd;
+		const char								*_blockText;
+		size_t									_blockOffset;
+		bool									_finished;
+		std::vector<ColorFormat::Attributes>	_styles;		/**< Attributes defined in the block */
+
+		static uint64_t readNumber(const char *&position, const char *end);
+};
@@ -0,0 +1,153 @@
+#include "TerminalSize.hpp"
+
+/* ############################################################################################## */
+
+/**
+ * @file TerminalSize.cpp
+ * @brief Implementation of the TerminalSize class.
+ *
+ * This file contains the query of the size, through `ioctl(TIOCGWINSZ)` on POSIX systems
+ * and the environment elsewhere, and the SIGWINCH handler that invalidates it.
+ *
+ * @author aheitz
+ * @date Created: 2026-10-17
+ * @date Last Modified: 2026-10-17
+ */
+
+/* ############################################################################################## */
+
+/*
+ * This file is part of the ColorFormat library.
+ *
+ * Copyright (C) 2025 aheitz <alexy.pa.heitz@gmail.com>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+/* ############################################################################################## */
+
+#include <cerrno>
+#include <cstdlib>
+#include <mutex>
+#if defined(__unix__) or defined(__APPLE__)
+# include <signal.h>
+# include <sys/ioctl.h>
+# include <unistd.h>
+# define TERMINALSIZE_POSIX 1
+#endif
+
+/* ############################################################################################## */
+
+std::atomic<uint32_t> TerminalSize::_size(0);
+std::atomic<uint32_t> TerminalSize::_generation(0);
+
+#ifdef TERMINALSIZE_POSIX
+/** Handler of SIGWINCH installed before ours */
+static struct sigaction previousHandler;
+
+/**
+ * @brief Handles SIGWINCH: invalidates the cached size, then calls the previous handler.
+ */
+static void resized(const int signal, siginfo_t *information, void *context) {
+	const int error = errno;
+
+	TerminalSize::invalidate();
+	if (previousHandler.sa_flags & SA_SIGINFO)
+		previousHandler.sa_sigaction(signal, information, context);
+	else if (previousHandler.sa_handler != SIG_DFL and previousHandler.sa_handler != SIG_IGN)
+		previousHandler.sa_handler(signal);
+	errno = error;
+}
+#endif
+
+/* ############################################################################################## */
+
+/**
+ * @brief Reads a dimension from the environment.
+ *
+ * @param name The variable, such as `COLUMNS`.
+ * @param fallback The value used if the variable is unset or not a number from 1 to 65535.
+ * @return unsigned int The dimension.
+ */
+static unsigned int environmentDimension(const char *name, const unsigned int fallback) {
+	const char *value = std::getenv(name);
+	char	   *end	  = NULL;
+
+	if (!value or !*value)
+		return fallback;
+
+	const unsigned long dimension = std::strtoul(value, &end, 10);
+	return *end == '\0' and dimension >= 1 and dimension <= 0xFFFF ? static_cast<unsigned int>(dimension) : fallback;
+}
+
+/**
+ * @brief Queries the size and caches it.
+ *
+ * If the window is resized during the query, the value is cached as unknown so that
+ * the next lookup queries it again, instead of keeping it until the next resize. The store
+ * of the size and the check of the generation are sequentially consistent, as are the two
+ * writes of invalidate(): either the check sees the new generation, or the store comes before
+ * the increment, hence before the reset that follows it.
+ *
+ * @return uint32_t The packed size.
+ */
+uint32_t TerminalSize::refresh(void) {
+	const uint32_t generation = _generation.load(std::memory_order_acquire);
+	unsigned int   columns	  = 0;
+	unsigned int   rows		  = 0;
+
+#ifdef TERMINALSIZE_POSIX
+	struct winsize window;
+	if (ioctl(STDOUT_FILENO, TIOCGWINSZ, &window) == 0) {
+		watch();
+		columns = window.ws_col;
+		rows	= window.ws_row;
+	}
+#endif
+	if (!columns)
+		columns = environmentDimension("COLUMNS", defaultColumns);
+	if (!rows)
+		rows = environmentDimension("LINES", defaultRows);
+
+	const uint32_t size = static_cast<uint32_t>(columns) << 16 | static_cast<uint32_t>(rows);
+	_size.store(size, std::memory_order_seq_cst);
+	if (_generation.load(std::memory_order_seq_cst) != generation)
+		_size.store(0, std::memory_order_relaxed);
+	return size;
+}
+
+void TerminalSize::invalidate(void) {
+	_generation.fetch_add(1, std::memory_order_seq_cst);
+	_size.store(0, std::memory_order_seq_cst);
+}
+
+/**
+ * @brief Installs the SIGWINCH handler, once.
+ *
+ * A handler installed before is kept and called after the cache is invalidated.
+ */
+void TerminalSize::watch(void) {
+#ifdef TERMINALSIZE_POSIX
+	static std::once_flag installed;
+
+	std::call_once(installed, [] {
+		struct sigaction action;
+
+		action.sa_sigaction = resized;
+		action.sa_flags		= SA_SIGINFO | SA_RESTART;
+		sigemptyset(&action.sa_mask);
+		sigaction(SIGWINCH, &action, &previousHandler);
+	});
+#endif
+}
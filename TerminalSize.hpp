@@ -0,0 +1,99 @@
+#pragma once
+
+/* ############################################################################################## */
+
+/**
+ * @file TerminalSize.hpp
+ * @brief Declaration of the TerminalSize class, a cached size of the terminal.
+ *
+ * The size is queried once and cached, so renderers can look it up for every line
+ * at the cost of an atomic load:
+ * ```
+ * const unsigned int width = TerminalSize::columns();
+ * std::cout << std::string(width, '-') << std::endl;
+ * ```
+ * A SIGWINCH handler, installed on the first query of a terminal, invalidates the cache
+ * when the window is resized. When the standard output is not a terminal, the size is
+ * read from the `COLUMNS` and `LINES` environment variables, then defaults to 80x24.
+ *
+ * Requires C++11.
+ *
+ * @author aheitz
+ * @date Created: 2026-10-17
+ * @date Last Modified: 2026-10-17
+ */
+
+/* ############################################################################################## */
+
+/*
+ * This file is part of the ColorFormat library.
+ *
+ * Copyright (C) 2025 aheitz <alexy.pa.heitz@gmail.com>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+/* ############################################################################################## */
+
+#include <atomic>
+#include <stdint.h>
+
+/* ############################################################################################## */
+
+/**
+ * @brief Process-wide size of the terminal of the standard output.
+ */
+class TerminalSize {
+	public:
+		enum { defaultColumns = 80, defaultRows = 24 };
+
+		/** @name Cached lookups */
+		/** @{ */
+		static unsigned int columns(void);
+		static unsigned int rows(void);
+		/** @} */
+
+		/**
+		 * @brief Forgets the cached size, which is queried again on the next lookup.
+		 *
+		 * Async-signal-safe, for programs handling SIGWINCH themselves.
+		 */
+		static void invalidate(void);
+	private:
+		static std::atomic<uint32_t>	_size;			/**< Columns in the high half, rows in the low half, 0 if unknown */
+		static std::atomic<uint32_t>	_generation;	/**< Incremented by invalidate() */
+
+		static uint32_t refresh(void);
+		static void watch(void);
+
+		TerminalSize(void) = delete;
+};
+
+/* ############################################################################################## */
+
+inline unsigned int TerminalSize::columns(void) {
+	uint32_t size = _size.load(std::memory_order_relaxed);
+
+	if (!size)
+		size = refresh();
+	return size >> 16;
+}
+
+inline unsigned int TerminalSize::rows(void) {
+	uint32_t size = _size.load(std::memory_order_relaxed);
+
+	if (!size)
+		size = refresh();
+	return size & 0xFFFF;
+}
@@ -0,0 +1,100 @@
+/* ############################################################################################## */
+
+/**
+ * @file ArenaBench.cpp
+ * @brief Compares formatting into std::string results against appending into per-request arenas.
+ *
+ * Each request formats a few styled fields. The first path builds them with the std::string
+ * functions; the second appends them to a std::pmr::string backed by a monotonic_buffer_resource,
+ * released at once at the end of the request. Every path runs on 1 to N threads to expose
+ * the contention of the global allocator.
+ *
+ * Build: g++ -std=c++17 -O2 -pthread -I.. ArenaBench.cpp ../ColorFormat.cpp -o ArenaBench
+ * Usage: ./ArenaBench [threads]
+ *
+ * @author aheitz
+ * @date Created: 2026-10-17
+ * @date Last Modified: 2026-10-17
+ */
+
+/* ############################################################################################## */
+
+#include "ColorFormat.hpp"
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <memory_resource>
+#include <string>
+#include <thread>
+#include <vector>
+
+/* ############################################################################################## */
+
+static const unsigned int requests		   = 200000;
+static const unsigned int fieldsPerRequest = 8;
+
+/**
+ * @brief Formats the fields of a request into std::string results.
+ */
+static size_t heapRequest(const unsigned int request) {
+	std::string line;
+
+	for (unsigned int field = 0 ; field < fieldsPerRequest ; field++) {
+		line += ColorFormat::formatString("status", "red", "bold");
+		line += ColorFormat::formatUnsignedInteger(request * field, "underline");
+		line += ColorFormat::formatGradientUnsignedInteger((request + field) % 120, 0, 100);
+	}
+	return line.size();
+}
+
+/**
+ * @brief Appends the fields of a request into an arena, released when the request ends.
+ */
+static size_t arenaRequest(const unsigned int request) {
+	char								buffer[4096];
+	std::pmr::monotonic_buffer_resource arena(buffer, sizeof(buffer));
+	std::pmr::string					line(&arena);
+
+	for (unsigned int field = 0 ; field < fieldsPerRequest ; field++) {
+		ColorFormat::appendString(line, "status", "red", "bold");
+		ColorFormat::appendUnsignedInteger(line, request * field, "underline");
+		ColorFormat::appendGradientUnsignedInteger(line, (request + field) % 120, 0, 100);
+	}
+	return line.size();
+}
+
+/**
+ * @brief Runs the requests on several threads and prints their cost per request.
+ */
+static void measure(const char *name, size_t (*request)(unsigned int), const unsigned int threadCount) {
+	std::vector<std::thread> threads;
+	std::vector<size_t>		 bytes(threadCount);
+
+	const std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+	for (unsigned int thread = 0 ; thread < threadCount ; thread++)
+		threads.emplace_back([&bytes, request, thread] {
+			size_t total = 0;
+
+			/* Summed locally: adjacent slots of bytes would share a cache line between threads */
+			for (unsigned int i = 0 ; i < requests ; i++)
+				total += request(i);
+			bytes[thread] = total;
+		});
+	for (std::thread &thread : threads)
+		thread.join();
+	const std::chrono::duration<double, std::nano> elapsed = std::chrono::steady_clock::now() - start;
+
+	std::printf("%-16s %2u threads %8.1f ns/request (%zu bytes per thread)\n",
+				name, threadCount, elapsed.count() / requests, bytes[0]);
+}
+
+int main(int argc, char **argv) {
+	const unsigned int maximumThreads = argc > 1 ? static_cast<unsigned int>(std::atoi(argv[1])) : std::thread::hardware_concurrency();
+
+	for (unsigned int threadCount = 1 ; threadCount <= (maximumThreads ? maximumThreads : 1) ; threadCount *= 2) {
+		measure("std::string", heapRequest, threadCount);
+		measure("pmr arena", arenaRequest, threadCount);
+	}
+	return 0;
+}
@@ -0,0 +1,143 @@
+/* ############################################################################################## */
+
+/**
+ * @file CompactFormatBench.cpp
+ * @brief Compares the memory used by a ring buffer of ColorFormat and CompactFormat entries.
+ *
+ * The ring keeps the formatted messages of the last events. Every global allocation is
+ * counted, so the reported footprint includes the heap blocks of the entries; the texts
+ * of the compact entries live in a separate pool, reported on its own. The ring is then
+ * rendered once to a discarding writer to show the cost of formatting on demand.
+ *
+ * Build: g++ -std=c++17 -O2 -I.. CompactFormatBench.cpp ../ColorFormat.cpp ../BufferedWriter.cpp -o CompactFormatBench
+ * Usage: ./CompactFormatBench [entries]
+ *
+ * @author aheitz
+ * @date Created: 2026-10-17
+ * @date Last Modified: 2026-10-17
+ */
+
+/* ############################################################################################## */
+
+#include "BufferedWriter.hpp"
+#include "ColorFormat.hpp"
+#include "CompactFormat.hpp"
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <new>
+#include <string>
+#include <vector>
+
+/* ############################################################################################## */
+
+static size_t allocatedBytes = 0;
+
+void *operator new(const size_t size) {
+	allocatedBytes += size;
+	if (void *block = std::malloc(size ? size : 1))
+		return block;
+	throw std::bad_alloc();
+}
+
+void operator delete(void *block) noexcept { std::free(block); }
+void operator delete(void *block, size_t) noexcept { std::free(block); }
+
+static void discard(void *, const char *, size_t) {}
+
+/* ############################################################################################## */
+
+static const char *const messages[] = {
+	"connection reset by peer",
+	"request completed in 12ms",
+	"cache miss for key user:1842:profile",
+	"retrying upload of chunk 17/64 after timeout",
+	"disk usage above 90% on /var/lib/postgresql"
+};
+static const size_t messageCount = sizeof(messages) / sizeof(messages[0]);
+
+static ColorFormat::Attributes attributesOf(const size_t event) {
+	return event % 3 ? static_cast<ColorFormat::Attributes>(ColorFormat::yellow)
+					 : static_cast<ColorFormat::Attributes>(ColorFormat::red) | ColorFormat::bold;
+}
+
+/**
+ * @brief Renders a ring to a discarding writer and returns the time taken, in milliseconds.
+ */
+template <typename Entry, typename Render>
+static double render(const std::vector<Entry> &ring, Render renderEntry) {
+	BufferedWriter writer(discard, NULL);
+
+	const std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+	for (const Entry &entry : ring)
+		renderEntry(entry, writer);
+	writer.flush();
+	return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+}
+
+static void report(const char *name, const size_t entries, const size_t bytes, const size_t shared, const double milliseconds) {
+	std::printf("%-28s %6.1f bytes/entry  (+ %5.1f of shared text)  rendered in %7.1f ms\n",
+				name, static_cast<double>(bytes) / entries, static_cast<double>(shared) / entries, milliseconds);
+}
+
+/* ############################################################################################## */
+
+int main(int argc, char **argv) {
+	const size_t entries = argc > 1 ? std::strtoul(argv[1], NULL, 10) : 1000000;
+
+	std::printf("%zu entries; sizeof(ColorFormat) = %zu, sizeof(CompactFormat) = %zu\n\n",
+				entries, sizeof(ColorFormat), sizeof(CompactFormat));
+
+	{
+		allocatedBytes = 0;
+		std::vector<ColorFormat> ring;
+		ring.reserve(entries);
+		for (size_t event = 0 ; event < entries ; event++) {
+			const ColorFormat::Attributes attributes = attributesOf(event);
+			ring.push_back(ColorFormat(messages[event % messageCount], attributes & ColorFormat::bold ? "red" : "yellow",
+									   attributes & ColorFormat::bold ? "bold" : ""));
+		}
+		const size_t bytes = allocatedBytes;
+		report("ColorFormat (eager)", entries, bytes, 0, render(ring, [](const ColorFormat &entry, BufferedWriter &writer) {
+			const std::string &text = entry.getFormattedString();
+			writer.append(text.data(), text.size());
+		}));
+	}
+	{
+		std::vector<std::string> pool(messages, messages + messageCount);
+		allocatedBytes = 0;
+		std::vector<ColorFormat> ring;
+		ring.reserve(entries);
+		for (size_t event = 0 ; event < entries ; event++)
+			ring.push_back(ColorFormat::lazy(pool[event % messageCount], attributesOf(event)));
+		const size_t bytes = allocatedBytes;
+		report("ColorFormat::lazy", entries, bytes, 0, render(ring, [](const ColorFormat &entry, BufferedWriter &writer) {
+			const std::string &text = entry.getFormattedString();
+			writer.append(text.data(), text.size());
+		}));
+	}
+	{
+		/* Texts interned in one pool, as an arena or a string table would keep them */
+		allocatedBytes = 0;
+		std::string pool;
+		for (size_t i = 0 ; i < messageCount ; i++)
+			pool += messages[i];
+		const size_t shared = allocatedBytes;
+
+		allocatedBytes = 0;
+		std::vector<CompactFormat> ring;
+		ring.reserve(entries);
+		for (size_t event = 0, offset = 0 ; event < entries ; event++) {
+			const size_t message = event % messageCount;
+			const size_t length	 = std::char_traits<char>::length(messages[message]);
+			ring.push_back(CompactFormat(attributesOf(event), pool.data() + offset, length));
+			offset = message + 1 == messageCount ? 0 : offset + length;
+		}
+		const size_t bytes = allocatedBytes;
+		report("CompactFormat", entries, bytes, shared, render(ring, [](const CompactFormat &entry, BufferedWriter &writer) {
+			entry.append(writer);
+		}));
+	}
+	return 0;
+}
@@ -0,0 +1,90 @@
+/* ############################################################################################## */
+
+/**
+ * @file DiffColorizerBench.cpp
+ * @brief Measures the throughput of DiffColorizer on a generated unified diff fed in chunks.
+ *
+ * Build: g++ -std=c++11 -O2 -march=native -I.. DiffColorizerBench.cpp ../DiffColorizer.cpp ../BufferedWriter.cpp ../ColorFormat.cpp -o DiffColorizerBench
+ *
+ * @author aheitz
+ * @date Created: 2026-10-17
+ * @date Last Modified: 2026-10-17
+ */
+
+/* ############################################################################################## */
+
+#include "DiffColorizer.hpp"
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <string>
+
+/* ############################################################################################## */
+
+static const size_t inputSize = 128 << 20;
+static const size_t chunkSize = 64 << 10;
+
+/**
+ * @brief Counts the bytes it receives, to measure the colorizer without the cost of a terminal.
+ */
+static void discard(void *destination, const char *, const size_t length) { *static_cast<size_t *>(destination) += length; }
+
+/**
+ * @brief Builds hunks of configuration lines, with a few changed values in each.
+ */
+static std::string generate(void) {
+	std::string diff = "--- a/state.conf\n+++ b/state.conf\n";
+	char		line[128];
+
+	std::srand(42);
+	for (int hunk = 0 ; diff.size() < inputSize ; hunk++) {
+		std::snprintf(line, sizeof(line), "@@ -%d,8 +%d,8 @@ section %d\n", hunk * 10, hunk * 10, hunk);
+		diff += line;
+		for (int i = 0 ; i < 3 ; i++) {
+			std::snprintf(line, sizeof(line), " service.%d.endpoint = https://host-%d.example.com:%d/api\n", i, std::rand() % 100, 8000 + i);
+			diff += line;
+		}
+		for (int i = 0 ; i < 2 ; i++) {
+			const int key = std::rand() % 1000;
+
+			std::snprintf(line, sizeof(line), "-limits.%d.connections = %d # tuned\n", key, std::rand() % 4096);
+			diff += line;
+			std::snprintf(line, sizeof(line), "+limits.%d.connections = %d # tuned\n", key, std::rand() % 4096);
+			diff += line;
+		}
+		for (int i = 0 ; i < 3 ; i++) {
+			std::snprintf(line, sizeof(line), " cache.%d.size = %dMiB\n", i, std::rand() % 512);
+			diff += line;
+		}
+	}
+	return diff;
+}
+
+/**
+ * @brief Colors the diff chunk by chunk and prints the throughput.
+ */
+static void measure(const char *name, const std::string &diff, const bool highlight) {
+	const std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+	size_t										bytes = 0;
+	{
+		BufferedWriter output(&discard, &bytes);
+		DiffColorizer  colorizer(output);
+
+		colorizer.highlightWords(highlight);
+		for (size_t i = 0 ; i < diff.size() ; i += chunkSize)
+			colorizer.write(diff.data() + i, diff.size() - i < chunkSize ? diff.size() - i : chunkSize);
+		colorizer.finish();
+	}
+	const std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+
+	std::printf("%-24s %8.3f GB/s of input (%zu bytes written)\n", name, diff.size() / elapsed.count() / 1e9, bytes);
+}
+
+int main(void) {
+	const std::string diff = generate();
+
+	measure("Lines only", diff, false);
+	measure("Words highlighted", diff, true);
+	return 0;
+}
@@ -0,0 +1,52 @@
+/* ############################################################################################## */
+
+/**
+ * @file FormatterBench.cpp
+ * @brief Compares std::format with ColorField against formatting through ColorFormat strings.
+ *
+ * Build: g++ -std=c++20 -O2 -I.. FormatterBench.cpp ../ColorFormat.cpp -o FormatterBench
+ *
+ * @author aheitz
+ * @date Created: 2026-10-17
+ * @date Last Modified: 2026-10-17
+ */
+
+/* ############################################################################################## */
+
+#include "ColorFormatter.hpp"
+
+#include <chrono>
+#include <cstdio>
+#include <string>
+
+/* ############################################################################################## */
+
+static const unsigned int iterations = 1000000;
+
+/**
+ * @brief Runs one formatting path and prints its cost per line.
+ */
+template <typename Function>
+static void measure(const char *name, Function function) {
+	size_t bytes = 0;
+
+	const std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+	for (unsigned int i = 0 ; i < iterations ; i++)
+		bytes += function(i).size();
+	const std::chrono::duration<double, std::nano> elapsed = std::chrono::steady_clock::now() - start;
+
+	std::printf("%-28s %8.1f ns/line (%zu bytes)\n", name, elapsed.count() / iterations, bytes);
+}
+
+int main(void) {
+	measure("ColorFormat strings", [](unsigned int i) {
+		return std::format("{} took {}",
+						   ColorFormat::formatString("request", "red", "bold"),
+						   ColorFormat::formatGradientUnsignedInteger(i % 120, 0, 100));
+	});
+	measure("ColorField", [](unsigned int i) {
+		return std::format("{:red,bold} took {:grad(0,100)}",
+						   ColorField(std::string_view("request")), ColorField(i % 120));
+	});
+	return 0;
+}
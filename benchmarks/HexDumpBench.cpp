@@ -0,0 +1,81 @@
+/* ############################################################################################## */
+
+/**
+ * @file HexDumpBench.cpp
+ * @brief Measures the throughput of HexDump against a dump formatting each byte with formatString().
+ *
+ * Build: g++ -std=c++11 -O2 -march=native -I.. HexDumpBench.cpp ../HexDump.cpp ../BufferedWriter.cpp ../ColorFormat.cpp -o HexDumpBench
+ *
+ * @author aheitz
+ * @date Created: 2026-10-17
+ * @date Last Modified: 2026-10-17
+ */
+
+/* ############################################################################################## */
+
+#include "HexDump.hpp"
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <string>
+#include <vector>
+
+/* ############################################################################################## */
+
+static const size_t inputSize = 64 << 20;
+
+/**
+ * @brief Counts the bytes it receives, to measure the dump without the cost of a terminal.
+ */
+static void discard(void *destination, const char *, const size_t length) { *static_cast<size_t *>(destination) += length; }
+
+/**
+ * @brief Runs one dump over the input and prints its throughput.
+ */
+template <typename Function>
+static void measure(const char *name, const std::vector<unsigned char> &input, const size_t length, Function function) {
+	const std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+	const size_t								bytes = function(input.data(), length);
+	const std::chrono::duration<double>			elapsed = std::chrono::steady_clock::now() - start;
+
+	std::printf("%-28s %8.3f GB/s of input (%zu bytes written)\n", name, length / elapsed.count() / 1e9, bytes);
+}
+
+int main(void) {
+	std::vector<unsigned char> text(inputSize);
+	std::vector<unsigned char> binary(inputSize);
+
+	std::srand(42);
+	for (size_t i = 0 ; i < inputSize ; i++) {
+		text[i]	  = static_cast<unsigned char>(i % 61 == 60 ? '\n' : 'a' + std::rand() % 26);
+		binary[i] = static_cast<unsigned char>(std::rand());
+	}
+
+	const auto dump = [](const unsigned char *data, const size_t length) {
+		size_t		   bytes = 0;
+		BufferedWriter output(&discard, &bytes);
+
+		hexdump(data, length, output);
+		output.flush();
+		return bytes;
+	};
+	const auto perByte = [](const unsigned char *data, const size_t length) {
+		const char *const colors[5] = {"bright_black", "cyan", "green", "magenta", "yellow"};
+		char			  hex[3];
+		unsigned char	  byteClass;
+		size_t			  bytes = 0;
+
+		for (size_t i = 0 ; i < length ; i++) {
+			HexDump::classify(data + i, 1, &byteClass);
+			std::snprintf(hex, sizeof(hex), "%02x", data[i]);
+			bytes += ColorFormat::formatString(hex, colors[byteClass]).size() + 1;
+		}
+		return bytes;
+	};
+
+	measure("HexDump, text", text, inputSize, dump);
+	measure("HexDump, random bytes", binary, inputSize, dump);
+	measure("formatString per byte, text", text, inputSize / 16, perByte);
+	return 0;
+}
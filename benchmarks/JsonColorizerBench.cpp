@@ -0,0 +1,77 @@
+/* ############################################################################################## */
+
+/**
+ * @file JsonColorizerBench.cpp
+ * @brief Measures the throughput of JsonColorizer on a generated document fed in chunks.
+ *
+ * Build: g++ -std=c++11 -O2 -march=native -I.. JsonColorizerBench.cpp ../JsonColorizer.cpp ../BufferedWriter.cpp ../ColorFormat.cpp -o JsonColorizerBench
+ *
+ * @author aheitz
+ * @date Created: 2026-10-17
+ * @date Last Modified: 2026-10-17
+ */
+
+/* ############################################################################################## */
+
+#include "JsonColorizer.hpp"
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <string>
+
+/* ############################################################################################## */
+
+static const size_t inputSize = 64 << 20;
+static const size_t chunkSize = 64 << 10;
+
+/**
+ * @brief Counts the bytes it receives, to measure the colorizer without the cost of a terminal.
+ */
+static void discard(void *destination, const char *, const size_t length) { *static_cast<size_t *>(destination) += length; }
+
+/**
+ * @brief Builds an array of records mixing every kind of token.
+ */
+static std::string generate(void) {
+	std::string document = "[\n";
+	char		record[256];
+
+	std::srand(42);
+	while (document.size() < inputSize) {
+		std::snprintf(record, sizeof(record),
+					  "  {\"id\": %d, \"name\": \"user %d with a \\\"quoted\\\" nickname\", \"score\": %d.%02d, \"active\": %s, \"tags\": [\"a\", \"b\", null]},\n",
+					  std::rand(), std::rand() % 1000, std::rand() % 100, std::rand() % 100, std::rand() % 2 ? "true" : "false");
+		document += record;
+	}
+	document += "  {}\n]\n";
+	return document;
+}
+
+/**
+ * @brief Colors the document chunk by chunk and prints the throughput.
+ */
+static void measure(const char *name, const std::string &document, const unsigned int indentWidth) {
+	const std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+	size_t										bytes = 0;
+	{
+		BufferedWriter output(&discard, &bytes);
+		JsonColorizer  colorizer(output);
+
+		colorizer.indent(indentWidth);
+		for (size_t i = 0 ; i < document.size() ; i += chunkSize)
+			colorizer.write(document.data() + i, document.size() - i < chunkSize ? document.size() - i : chunkSize);
+		colorizer.finish();
+	}
+	const std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+
+	std::printf("%-24s %8.3f GB/s of input (%zu bytes written)\n", name, document.size() / elapsed.count() / 1e9, bytes);
+}
+
+int main(void) {
+	const std::string document = generate();
+
+	measure("Whitespace kept", document, 0);
+	measure("Re-indented by 2", document, 2);
+	return 0;
+}
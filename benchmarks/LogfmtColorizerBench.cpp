@@ -0,0 +1,76 @@
+/* ############################################################################################## */
+
+/**
+ * @file LogfmtColorizerBench.cpp
+ * @brief Measures the throughput of LogfmtColorizer on generated logfmt lines fed in chunks.
+ *
+ * Build: g++ -std=c++11 -O2 -march=native -I.. LogfmtColorizerBench.cpp ../LogfmtColorizer.cpp ../ColorTheme.cpp ../BufferedWriter.cpp ../ColorFormat.cpp -o LogfmtColorizerBench -pthread
+ *
+ * @author aheitz
+ * @date Created: 2026-10-17
+ * @date Last Modified: 2026-10-17
+ */
+
+/* ############################################################################################## */
+
+#include "LogfmtColorizer.hpp"
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <string>
+
+/* ############################################################################################## */
+
+static const size_t inputSize = 128 << 20;
+static const size_t chunkSize = 64 << 10;
+
+/**
+ * @brief Counts the bytes it receives, to measure the colorizer without the cost of a terminal.
+ */
+static void discard(void *destination, const char *, const size_t length) { *static_cast<size_t *>(destination) += length; }
+
+static std::string generate(void) {
+	static const char *const levels[]	= {"info", "warn", "error", "debug"};
+	static const char *const messages[] = {"request served", "cache miss", "upstream \\\"api\\\" timed out", "session closed"};
+	std::string				 log;
+	char					 line[256];
+
+	std::srand(42);
+	while (log.size() < inputSize) {
+		std::snprintf(line, sizeof(line), "ts=2026-10-17T12:%02d:%02d.%03dZ level=%s msg=\"%s\" method=GET path=/api/v1/items/%d status=%d dur=%dms\n",
+					  std::rand() % 60, std::rand() % 60, std::rand() % 1000, levels[std::rand() % 4], messages[std::rand() % 4],
+					  std::rand() % 10000, std::rand() % 2 ? 200 : 404, std::rand() % 800);
+		log += line;
+	}
+	return log;
+}
+
+/**
+ * @brief Colors the log chunk by chunk and prints the throughput.
+ */
+static void measure(const char *name, const std::string &log, const bool gradient) {
+	const std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+	size_t										bytes = 0;
+	{
+		BufferedWriter	output(&discard, &bytes);
+		LogfmtColorizer colorizer(output);
+
+		if (gradient)
+			colorizer.range("dur", 500, 0).range("status", 500, 200);
+		for (size_t i = 0 ; i < log.size() ; i += chunkSize)
+			colorizer.write(log.data() + i, log.size() - i < chunkSize ? log.size() - i : chunkSize);
+		colorizer.finish();
+	}
+	const std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+
+	std::printf("%-24s %8.1f MB/s of input (%zu bytes written)\n", name, log.size() / elapsed.count() / 1e6, bytes);
+}
+
+int main(void) {
+	const std::string log = generate();
+
+	measure("Keys, values, levels", log, false);
+	measure("With gradients", log, true);
+	return 0;
+}
@@ -0,0 +1,151 @@
+/* ############################################################################################## */
+
+/**
+ * @file PatternHighlighterBench.cpp
+ * @brief Measures PatternHighlighter against std::regex on generated log lines.
+ *
+ * Both highlight the same UUIDs, IPv4 addresses, hexadecimal identifiers and `key=` prefixes.
+ * A log file can be given as the first argument instead of the generated lines. Lines made of
+ * one long token without any match, such as a base64 blob, are then measured alone: their cost
+ * must stay linear in their length.
+ *
+ * Build: g++ -std=c++11 -O2 -march=native -I.. PatternHighlighterBench.cpp ../PatternHighlighter.cpp ../BufferedWriter.cpp ../ColorFormat.cpp -o PatternHighlighterBench
+ *
+ * @author aheitz
+ * @date Created: 2026-10-17
+ * @date Last Modified: 2026-10-17
+ */
+
+/* ############################################################################################## */
+
+#include "PatternHighlighter.hpp"
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <regex>
+#include <string>
+#include <vector>
+
+/* ############################################################################################## */
+
+static const size_t lineCount = 200000;
+
+/**
+ * @brief Builds log lines in the style of a web service.
+ */
+static std::vector<std::string> generate(void) {
+	static const char *const levels[]  = {"INFO", "WARN", "ERROR", "DEBUG"};
+	static const char *const actions[] = {"request served", "cache miss", "retrying upstream", "session closed"};
+	std::vector<std::string> lines;
+	char					 line[256];
+
+	std::srand(42);
+	for (size_t i = 0 ; i < lineCount ; i++) {
+		std::snprintf(line, sizeof(line),
+					  "2026-10-17T12:%02d:%02d.%03dZ %s %s request_id=%08x-%04x-4%03x-a%03x-%012llx client=10.%d.%d.%d:%d latency_ms=%d span=%016llx",
+					  std::rand() % 60, std::rand() % 60, std::rand() % 1000, levels[std::rand() % 4], actions[std::rand() % 4],
+					  std::rand(), std::rand() % 0x10000, std::rand() % 0x1000, std::rand() % 0x1000, static_cast<unsigned long long>(std::rand()) * std::rand(),
+					  std::rand() % 256, std::rand() % 256, std::rand() % 256, 1024 + std::rand() % 60000, std::rand() % 2000,
+					  static_cast<unsigned long long>(std::rand()) << 32 | std::rand());
+		lines.push_back(line);
+	}
+	return lines;
+}
+
+/**
+ * @brief Builds lines of a single unpadded base64url token: word characters and `-` with no
+ * `=`, which keep a `key=` candidate alive to the end of the line.
+ */
+static std::vector<std::string> generateTokens(const size_t count, const size_t length) {
+	static const char		 alphabet[] = "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789-_";
+	std::vector<std::string> lines(count, std::string(length, ' '));
+
+	for (size_t i = 0 ; i < count ; i++)
+		for (size_t j = 0 ; j < length ; j++)
+			lines[i][j] = alphabet[std::rand() % (sizeof(alphabet) - 1)];
+	return lines;
+}
+
+/**
+ * @brief Highlights every line and prints the throughput.
+ */
+template <typename Function>
+static void measure(const char *name, const std::vector<std::string> &lines, const size_t bytes, Function function) {
+	const std::chrono::steady_clock::time_point start	= std::chrono::steady_clock::now();
+	size_t										written = 0;
+
+	for (size_t i = 0 ; i < lines.size() ; i++)
+		written += function(lines[i]);
+
+	const std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+
+	std::printf("%-24s %8.1f MB/s (%zu bytes written)\n", name, bytes / elapsed.count() / 1e6, written);
+}
+
+int main(const int argc, const char **argv) {
+	std::vector<std::string> lines;
+	size_t					 bytes = 0;
+
+	if (argc > 1) {
+		std::ifstream file(argv[1]);
+		std::string	  line;
+
+		while (std::getline(file, line))
+			lines.push_back(line);
+	} else
+		lines = generate();
+	for (size_t i = 0 ; i < lines.size() ; i++)
+		bytes += lines[i].size();
+
+	PatternHighlighter highlighter;
+	std::string		   output;
+
+	highlighter.addLogPatterns();
+	std::printf("DFA: %zu states, %zu byte classes\n", highlighter.stateCount(), highlighter.byteClassCount());
+	measure("PatternHighlighter", lines, bytes, [&](const std::string &line) {
+		output.clear();
+		return highlighter.append(output, line.data(), line.size()).size();
+	});
+
+	/* The same patterns in one alternation; std::regex takes the first alternative that matches, not the longest */
+	const std::regex  pattern("([0-9a-fA-F]{8}-[0-9a-fA-F]{4}-[0-9a-fA-F]{4}-[0-9a-fA-F]{4}-[0-9a-fA-F]{12})"
+							  "|(\\d{1,3}(\\.\\d{1,3}){3}(:\\d{1,5})?)|(0x[0-9a-fA-F]+|[0-9a-f]{12,})|([A-Za-z_][\\w.\\-]*=)");
+	const char *const colors[] = {"\033[33m", "\033[35m", "\033[36m", "\033[34m"};
+	const int		  groups[] = {1, 2, 5, 6};
+
+	measure("std::regex", lines, bytes, [&](const std::string &line) {
+		std::sregex_iterator match(line.begin(), line.end(), pattern);
+		size_t				 position = 0;
+
+		output.clear();
+		for ( ; match != std::sregex_iterator() ; ++match) {
+			int group = 0;
+
+			while (!(*match)[groups[group]].matched)
+				group++;
+			output.append(line, position, match->position() - position);
+			output += colors[group];
+			output += match->str();
+			output += "\033[0m";
+			position = match->position() + match->length();
+		}
+		output.append(line, position, std::string::npos);
+		return output.size();
+	});
+
+	const size_t lengths[] = {1000, 10000, 100000};
+
+	for (size_t i = 0 ; i < sizeof(lengths) / sizeof(lengths[0]) ; i++) {
+		const std::vector<std::string> tokens = generateTokens(10000000 / lengths[i], lengths[i]);
+		char						   name[48];
+
+		std::snprintf(name, sizeof(name), "Tokens of %zu bytes", lengths[i]);
+		measure(name, tokens, tokens.size() * lengths[i], [&](const std::string &line) {
+			output.clear();
+			return highlighter.append(output, line.data(), line.size()).size();
+		});
+	}
+	return 0;
+}
@@ -0,0 +1,88 @@
+/* ############################################################################################## */
+
+/**
+ * @file SgrRewriterBench.cpp
+ * @brief Measures the throughput of SgrRewriter on a truecolor log fed in chunks, without
+ * mappings (minimization alone), for each color depth and for a theme swap.
+ *
+ * Build: g++ -std=c++11 -O2 -march=native -I.. SgrRewriterBench.cpp ../SgrRewriter.cpp ../BufferedWriter.cpp ../ColorFormat.cpp -o SgrRewriterBench
+ *
+ * @author aheitz
+ * @date Created: 2026-10-17
+ * @date Last Modified: 2026-10-17
+ */
+
+/* ############################################################################################## */
+
+#include "SgrRewriter.hpp"
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <string>
+
+/* ############################################################################################## */
+
+static const size_t inputSize = 64 << 20;
+static const size_t chunkSize = 64 << 10;
+
+/**
+ * @brief Counts the bytes it receives, to measure the rewriter without the cost of a terminal.
+ */
+static void discard(void *destination, const char *, const size_t length) { *static_cast<size_t *>(destination) += length; }
+
+/**
+ * @brief Builds log lines with a truecolor gradient banner every ten lines, 256-color
+ * timestamps and red or green levels.
+ */
+static std::string generate(void) {
+	static const char *const levels[] = {"red", "green", "yellow"};
+	std::string				 log;
+	char					 line[128];
+
+	std::srand(42);
+	for (size_t i = 0 ; log.size() < inputSize ; i++) {
+		if (i % 10 == 0)
+			log += ColorFormat::gradientText("==== deployment step ====", "#ff5f00", "#5f00ff", "bold") + '\n';
+		std::snprintf(line, sizeof(line), "12:%02d:%02d.%03d", std::rand() % 60, std::rand() % 60, std::rand() % 1000);
+		log += ColorFormat::formatString(line, "color(244)") + ' ' + ColorFormat::formatString("LEVEL", levels[std::rand() % 3], "bold");
+		std::snprintf(line, sizeof(line), " request served in %d ms\n", std::rand() % 800);
+		log += line;
+	}
+	return log;
+}
+
+/**
+ * @brief Rewrites the log chunk by chunk and prints the throughput.
+ */
+static void measure(const char *name, const std::string &log, SgrRewriter::ColorDepth depth, const bool theme) {
+	const std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+	size_t										bytes = 0;
+	ptrdiff_t									saved = 0;
+	{
+		BufferedWriter output(&discard, &bytes);
+		SgrRewriter	   rewriter(output);
+
+		rewriter.depth(depth);
+		if (theme)
+			rewriter.mapColor(ColorFormat::red, ColorFormat::rgb(230, 159, 0)).mapColor(ColorFormat::green, ColorFormat::rgb(86, 180, 233));
+		for (size_t i = 0 ; i < log.size() ; i += chunkSize)
+			rewriter.write(log.data() + i, log.size() - i < chunkSize ? log.size() - i : chunkSize);
+		rewriter.finish();
+		saved = rewriter.bytesSaved();
+	}
+	const std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+
+	std::printf("%-28s %8.1f MB/s of input (%zu of %zu bytes written, %.1f%% saved)\n", name, log.size() / elapsed.count() / 1e6, bytes, log.size(),
+				100.0 * saved / log.size());
+}
+
+int main(void) {
+	const std::string log = generate();
+
+	measure("Minimized, no mapping", log, SgrRewriter::trueColorDepth, false);
+	measure("256 colors", log, SgrRewriter::paletteDepth, false);
+	measure("16 colors", log, SgrRewriter::basicDepth, false);
+	measure("Theme swap, 16 colors", log, SgrRewriter::basicDepth, true);
+	return 0;
+}
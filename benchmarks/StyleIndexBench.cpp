@@ -0,0 +1,114 @@
+/* ############################################################################################## */
+
+/**
+ * @file StyleIndexBench.cpp
+ * @brief Measures how fast StyleIndex builds the index of colored log files, on one thread
+ * and on all of them, and how much of the logs a search by style skips.
+ *
+ * The logs are logfmt lines colored by LogfmtColorizer, written to temporary files; a few
+ * incidents leave durations out of the gradient range, shown blinking.
+ *
+ * Build: g++ -std=c++11 -O2 -march=native -I.. StyleIndexBench.cpp ../StyleIndex.cpp ../LogfmtColorizer.cpp ../ColorTheme.cpp ../BufferedWriter.cpp ../ColorFormat.cpp -o StyleIndexBench -pthread
+ * Usage: ./StyleIndexBench [files]
+ *
+ * @author aheitz
+ * @date Created: 2026-10-17
+ * @date Last Modified: 2026-10-17
+ */
+
+/* ############################################################################################## */
+
+#include "LogfmtColorizer.hpp"
+#include "StyleIndex.hpp"
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+/* ############################################################################################## */
+
+static const size_t fileSize = 64 << 20;
+
+/**
+ * @brief Writes a colored log whose durations only leave their range during a few incidents.
+ * @return The size of the file.
+ */
+static size_t generate(const std::string &path, const unsigned int seed) {
+	static const char *const levels[] = {"info", "warn", "error", "debug"};
+	std::ofstream			 file(path.c_str(), std::ios::binary);
+	BufferedWriter			 output(file);
+	LogfmtColorizer			 colorizer(output);
+	char					 line[256];
+
+	std::srand(seed);
+	colorizer.range("dur", 1000, 0);
+	while (output.size() < fileSize) {
+		const bool incident = std::rand() % 200000 == 0;
+		const int  length	= std::snprintf(line, sizeof(line), "ts=2026-10-17T12:%02d:%02d.%03dZ level=%s msg=\"request served\" path=/api/v1/items/%d dur=%dms\n",
+											std::rand() % 60, std::rand() % 60, std::rand() % 1000, levels[std::rand() % 4],
+											std::rand() % 10000, incident ? 1000 + std::rand() % 5000 : std::rand() % 800);
+
+		colorizer.write(line, static_cast<size_t>(length));
+	}
+	colorizer.finish();
+	output.flush();
+	return output.size();
+}
+
+/**
+ * @brief Indexes the files and prints the throughput.
+ */
+static void measureIndexing(const std::vector<std::string> &paths, const size_t bytes, const unsigned int threads) {
+	const std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+	StyleIndex									index;
+
+	index.add(paths, threads);
+
+	const std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+
+	std::printf("Indexing on %2u thread(s)   %8.1f MB/s\n", threads, bytes / elapsed.count() / 1e6);
+}
+
+/**
+ * @brief Searches the files and prints the time taken and the blocks read.
+ */
+static void measureSearch(const char *name, const StyleIndex &index, const ColorFormat::Attributes query) {
+	const std::chrono::steady_clock::time_point start	= std::chrono::steady_clock::now();
+	const std::vector<StyleIndex::Match>		matches = index.find(query);
+	const std::chrono::duration<double>			elapsed = std::chrono::steady_clock::now() - start;
+	size_t										blocks	= 0;
+
+	for (size_t i = 0 ; i < index.fileCount() ; i++)
+		blocks += index.blocks(i).size();
+	std::printf("%-26s %8.2f ms, %zu matches, %zu of %zu blocks read\n", name, elapsed.count() * 1e3, matches.size(),
+				index.candidateBlocks(query), blocks);
+}
+
+int main(const int argc, const char **argv) {
+	const size_t			 fileCount = argc > 1 ? std::strtoul(argv[1], NULL, 10) : 8;
+	std::vector<std::string> paths;
+	size_t					 bytes = 0;
+
+	for (size_t i = 0 ; i < fileCount ; i++) {
+		paths.push_back("StyleIndexBench-" + std::to_string(i) + ".log");
+		bytes += generate(paths.back(), static_cast<unsigned int>(i));
+	}
+	std::printf("%zu files, %zu bytes\n\n", fileCount, bytes);
+
+	measureIndexing(paths, bytes, 1);
+	measureIndexing(paths, bytes, std::thread::hardware_concurrency());
+
+	StyleIndex index;
+
+	index.add(paths);
+	std::printf("\n");
+	measureSearch("Out of range (blink, bold)", index, ColorFormat::blink | ColorFormat::bold);
+	measureSearch("Red", index, ColorFormat::red);
+	for (size_t i = 0 ; i < paths.size() ; i++)
+		std::remove(paths[i].c_str());
+	return 0;
+}
@@ -0,0 +1,171 @@
+/* ############################################################################################## */
+
+/**
+ * @file StyledLogBench.cpp
+ * @brief Compares the size of colored logs stored with escape sequences and in the styled log
+ * format, and measures the throughput of encoding and of reading them back.
+ *
+ * Without an argument, logfmt lines are colored by LogfmtColorizer, with a rainbow banner
+ * every hundred lines; a file given as argument is used instead (e.g. the output of a
+ * build or a test run captured with its colors).
+ *
+ * Build: g++ -std=c++11 -O2 -march=native -I.. StyledLogBench.cpp ../StyledLog.cpp ../LogfmtColorizer.cpp ../RainbowStream.cpp ../ColorTheme.cpp ../BufferedWriter.cpp ../ColorFormat.cpp -o StyledLogBench -pthread
+ * Usage: ./StyledLogBench [colored log]
+ *
+ * @author aheitz
+ * @date Created: 2026-10-17
+ * @date Last Modified: 2026-10-17
+ */
+
+/* ############################################################################################## */
+
+#include "LogfmtColorizer.hpp"
+#include "RainbowStream.hpp"
+#include "StyledLog.hpp"
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <sstream>
+#include <string>
+
+/* ############################################################################################## */
+
+static const size_t lineCount = 500000;
+static const int	rounds	  = 5;
+
+/**
+ * @brief Counts the bytes it receives, to measure the decoders without the cost of a terminal.
+ */
+static void discard(void *destination, const char *, const size_t length) { *static_cast<size_t *>(destination) += length; }
+
+static std::string generate(void) {
+	static const char *const levels[]	= {"info", "warn", "error", "debug"};
+	static const char *const messages[] = {"request served", "cache miss", "upstream \\\"api\\\" timed out", "session closed"};
+	std::string				 log;
+	char					 line[256];
+	BufferedWriter			 output(log);
+	LogfmtColorizer			 colorizer(output);
+	RainbowStream			 rainbow(output, ColorFormat::bold);
+
+	std::srand(42);
+	colorizer.range("dur", 500, 0).range("status", 500, 200);
+	for (size_t i = 0 ; i < lineCount ; i++) {
+		if (i % 100 == 0) {
+			static const char banner[] = "=== checkpoint reached ===\n";
+
+			rainbow.write(banner, sizeof(banner) - 1);
+			rainbow.finish();
+		}
+
+		const int length = std::snprintf(line, sizeof(line), "ts=2026-10-17T12:%02d:%02d.%03dZ level=%s msg=\"%s\" method=GET path=/api/v1/items/%d status=%d dur=%dms\n",
+										 std::rand() % 60, std::rand() % 60, std::rand() % 1000, levels[std::rand() % 4], messages[std::rand() % 4],
+										 std::rand() % 10000, std::rand() % 2 ? 200 : 404, std::rand() % 800);
+
+		colorizer.write(line, static_cast<size_t>(length));
+	}
+	colorizer.finish();
+	output.flush();
+	return log;
+}
+
+/**
+ * @brief Runs a function a few times and prints the best throughput over `bytes`.
+ */
+template <typename Function>
+static void measure(const char *name, const size_t bytes, Function function) {
+	double best	   = 0;
+	size_t written = 0;
+
+	for (int round = 0 ; round < rounds ; round++) {
+		const std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+
+		written = function();
+
+		const std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+
+		if (bytes / elapsed.count() > best)
+			best = bytes / elapsed.count();
+	}
+	std::printf("%-32s %8.1f MB/s (%zu bytes written)\n", name, best / 1e6, written);
+}
+
+int main(const int argc, const char **argv) {
+	std::string log;
+
+	if (argc > 1) {
+		std::ifstream	  file(argv[1], std::ios::binary);
+		std::stringstream content;
+
+		content << file.rdbuf();
+		log = content.str();
+	} else
+		log = generate();
+
+	std::string stored;
+	{
+		BufferedWriter	 output(stored);
+		StyledLogEncoder encoder(output);
+
+		encoder.write(log.data(), log.size());
+		encoder.finish();
+	}
+
+	size_t plain = 0;
+	size_t runs	 = 0;
+	{
+		StyledLogReader		 reader(stored.data(), stored.size());
+		StyledLogReader::Run run;
+
+		while (reader.next(run)) {
+			plain += run.length;
+			++runs;
+		}
+	}
+	std::printf("With escape sequences       %10zu bytes\n", log.size());
+	std::printf("Styled log                  %10zu bytes (%.1f%% of the escaped log, %zu runs)\n", stored.size(), 100.0 * stored.size() / log.size(), runs);
+	std::printf("Plain text alone            %10zu bytes (%.1f%% of the escaped log)\n\n", plain, 100.0 * plain / log.size());
+
+	measure("Encoding (of the escaped log)", log.size(), [&]() {
+		size_t bytes = 0;
+		{
+			BufferedWriter	 output(&discard, &bytes);
+			StyledLogEncoder encoder(output);
+
+			encoder.write(log.data(), log.size());
+			encoder.finish();
+		}
+		return bytes;
+	});
+	measure("Reading runs (of the text)", plain, [&]() {
+		StyledLogReader		 reader(stored.data(), stored.size());
+		StyledLogReader::Run run;
+		size_t				 bytes = 0;
+
+		while (reader.next(run))
+			bytes += run.length;
+		return bytes;
+	});
+	measure("Decoding to ANSI (of the text)", plain, [&]() {
+		size_t bytes = 0;
+		{
+			BufferedWriter	output(&discard, &bytes);
+			StyledLogReader reader(stored.data(), stored.size());
+
+			reader.writeAnsi(output);
+		}
+		return bytes;
+	});
+	measure("Decoding to HTML (of the text)", plain, [&]() {
+		size_t bytes = 0;
+		{
+			BufferedWriter	output(&discard, &bytes);
+			StyledLogReader reader(stored.data(), stored.size());
+
+			reader.writeHtml(output);
+		}
+		return bytes;
+	});
+	return 0;
+}